@@ -511,6 +511,8 @@ static void overtemp_service_callback(void)
     update_all_sensors_threshold_counts();
     TempHandlingStateControl();
     PowerBackoffCalculationControl();
+    // 新的 P_current 已对 get_channel_power_backoff() 可见，标记延迟跟踪终点
+    rtc_trace_mark();
 }
 
 /**
@@ -549,6 +551,11 @@ int start_overtemp_service(void)
         DEBUG_LOG_SAMPLE(OVERTEMP_SERVICE, 0, "rtc_register_service overtemp failed\n");
         return -1;
     }
+    if (rtc_set_service_strand(0, "overtemp", OVERTEMP_RTC_STRAND) != 0) {
+        DEBUG_LOG_SAMPLE(OVERTEMP_SERVICE, 0, "rtc_set_service_strand overtemp failed\n");
+        rtc_unregister_service(0, "overtemp");
+        return -1;
+    }
 
     return 0;
 }
@@ -2,6 +2,15 @@
 #define OVER_TEMPERATURE_HANDLER_H
 
 
+/*==============================================================================
+ * 宏定义
+ *============================================================================*/
+
+// 过温服务所在的 RTC strand（串行执行器）名称
+// 读写过温全局量（如 P_current）的其他 RTC 服务加入同一 strand 后，
+// 与过温回调按 tick 顺序串行执行，无需额外加锁
+#define OVERTEMP_RTC_STRAND "dfe_ctrl"
+
 /*==============================================================================
  * 外部接口函数
  *============================================================================*/
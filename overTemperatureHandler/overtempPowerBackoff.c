@@ -1,5 +1,6 @@
 #include "overtempPowerBackoff.h"
 #include "overtempInternal.h"
+#include "overtempUtils.h"
 #include "dis_dfe8219_log.h"
 #include <stdbool.h>
 
@@ -64,7 +65,7 @@ static void accumulate_slowdrop_metrics_tick(uint8_t channel_id, sensor_attribut
         return;
     }
     int sensor_index = sensor->sensor_index;
-    float minutes_per_tick = (float)dynamicBackoffPeriod / 60.0f;
+    float minutes_per_tick = get_service_period_minutes();
     if (minutes_per_tick <= 0.0f) {
         return;
     }
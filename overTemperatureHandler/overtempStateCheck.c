@@ -1,8 +1,27 @@
 #include "overtempStateCheck.h"
 #include "overtempInternal.h"
+#include "overtempUtils.h"
 #include <stdbool.h>
 #include <stddef.h>
 
+/*==============================================================================
+ * 内部辅助函数
+ *============================================================================*/
+
+// TREC 最小保持时间对应的服务周期数（向上取整），周期长度与 THO/IHO 一样取 RTC 实测值
+static uint32_t trec_required_periods(void)
+{
+    float period_seconds = get_service_period_minutes() * 60.0f;
+    if (period_seconds <= 0.0f) {
+        return 0;
+    }
+    uint32_t periods = (uint32_t)(TREC_min_seconds / period_seconds);
+    if (periods * period_seconds < TREC_min_seconds) {
+        periods++;
+    }
+    return periods;
+}
+
 /*==============================================================================
  * 状态转换检查函数实现
  *============================================================================*/
@@ -64,7 +83,7 @@ bool check_holdoff_to_normal_transition(channel_t* channel)
     }
 
     // 计算达到最小保持时间所需的周期数（向上取整）
-    uint32_t required_ticks = (TREC_min_seconds + dynamicBackoffPeriod - 1) / dynamicBackoffPeriod;
+    uint32_t required_ticks = trec_required_periods();
     if (channel->trec_counter < required_ticks) {
         channel->trec_counter++;
         return false;
@@ -141,7 +160,7 @@ bool check_backoff_to_normal_transition(channel_t* channel)
     }
 
     // 计算达到最小保持时间所需的周期数（向上取整）
-    uint32_t required_ticks = (TREC_min_seconds + dynamicBackoffPeriod - 1) / dynamicBackoffPeriod;
+    uint32_t required_ticks = trec_required_periods();
     if (channel->trec_counter < required_ticks) {
         channel->trec_counter++;
         return false;
@@ -3,6 +3,7 @@
 #include "dis_dfe8219_log.h"
 #include "dis_dfe8219_dataBase.h"
 #include "dis_common_error_type.h"
+#include "rtcDriver.h"
 #include <string.h>
 #include <stdio.h>
 
@@ -82,13 +83,23 @@ void mark_channel_sensor_calc_mask(channel_t* channel)
     }
 }
 
+// 一个服务周期的实际分钟数：定时器分频截断会使 tick 偏离 1 秒，优先使用 RTC 实测值
+float get_service_period_minutes(void)
+{
+    double tick_seconds = rtc_get_tick_seconds(0);  // 过温服务注册在 timer0 上
+    if (tick_seconds <= 0.0) {
+        tick_seconds = 1.0;
+    }
+    return (float)(dynamicBackoffPeriod * tick_seconds / 60.0);
+}
+
 // 按通道-传感器维度在一个周期内累积 I_HO
 void accumulate_channel_iho_tick(channel_t* channel)
 {
     if (channel == NULL) {
         return;
     }
-    float minutes_per_tick = (float)dynamicBackoffPeriod / 60.0f;
+    float minutes_per_tick = get_service_period_minutes();
     if (minutes_per_tick <= 0.0f) {
         return;
     }
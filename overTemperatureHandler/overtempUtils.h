@@ -60,6 +60,12 @@ void mark_channel_sensor_calc_mask(channel_t* channel);
  */
 void accumulate_channel_iho_tick(channel_t* channel);
 
+/**
+ * @brief 获取一个服务周期对应的实际时长（分钟）
+ * @return 按 RTC 实测 tick 时长换算的分钟数；尚未测得时按 1 tick = 1 秒的标称值
+ */
+float get_service_period_minutes(void);
+
 /*==============================================================================
  * 更新计数器函数
  *============================================================================*/
@@ -0,0 +1,57 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+
+/*
+ * Copyright 2024 Disilicon
+ *
+ * Nuclei Basic Timer - character device ioctl interface
+ *
+ * Shared by the kernel driver (rtc-nuclei.c) and userspace (rtc/).
+ */
+
+#ifndef __RTC_NUCLEI_IOCTL_H__
+#define __RTC_NUCLEI_IOCTL_H__
+
+#include <linux/types.h>
+#include <linux/ioctl.h>
+
+/**
+ * struct nuclei_rtc_oneshot - one-pulse request
+ * @ticks: in, fire this many timer periods after the count last returned by read()
+ * @reserved: must be 0
+ * @count: out, count last returned by read(), the base of @ticks
+ *
+ * The interrupt count advances by the number of periods the pulse covered,
+ * so read() keeps returning a cumulative tick count in one-pulse mode.
+ * Requests longer than the ARR register can hold are clamped; userspace
+ * sees fewer elapsed ticks and programs the rest.
+ */
+struct nuclei_rtc_oneshot {
+	__u32 ticks;
+	__u32 reserved;
+	__u64 count;
+};
+
+#define NUCLEI_RTC_IOC_MAGIC		'n'
+/* Switch to one-pulse mode (TIMER_CR1_OPM) and program NUCLEI_ARR for the next deadline */
+#define NUCLEI_RTC_IOC_ONESHOT		_IOWR(NUCLEI_RTC_IOC_MAGIC, 1, struct nuclei_rtc_oneshot)
+/* Return to periodic mode with the device tree period */
+#define NUCLEI_RTC_IOC_PERIODIC		_IO(NUCLEI_RTC_IOC_MAGIC, 2)
+/* Read the CLOCK_MONOTONIC time (ns) of the last counted interrupt, 0 before the first */
+#define NUCLEI_RTC_IOC_IRQ_TIME		_IOR(NUCLEI_RTC_IOC_MAGIC, 3, __u64)
+
+/* Longest pulse, in periods, that fits in the 32-bit auto-reload register */
+static inline __u32 nuclei_rtc_oneshot_max_ticks(__u32 period)
+{
+	return period ? 0xFFFFFFFFU / period : 0;
+}
+
+/*
+ * Auto-reload value for a pulse of @ticks periods when @rem counts of the
+ * current period have already elapsed; keeps the pulse on the period grid.
+ */
+static inline __u32 nuclei_rtc_oneshot_arr(__u32 period, __u32 ticks, __u32 rem)
+{
+	return ticks * period - rem - 1;
+}
+
+#endif /* __RTC_NUCLEI_IOCTL_H__ */
@@ -26,6 +26,9 @@
 #include <linux/uaccess.h>
 #include <linux/mutex.h>
 #include <linux/atomic.h>
+#include <linux/timekeeping.h>
+
+#include "rtc-nuclei-ioctl.h"
 
 /* Registers */
 #define NUCLEI_CR1		0x00
@@ -115,8 +118,12 @@ struct nuclei_rtc {
 	dev_t dev_num;
 	wait_queue_head_t wait_queue;
 	unsigned long irq_count;
+	unsigned long reported_count;  // 最近一次read()返回的计数
 	bool irq_pending;
 	struct mutex irq_lock;
+	uint32_t oneshot_ticks;  // 单脉冲模式下当前脉冲覆盖的周期数，0表示周期模式
+	uint32_t pulse_rem;  // 当前脉冲启动时所在周期内已走过的计数值
+	u64 irq_ns;  // 最近一次计数中断的时间戳（CLOCK_MONOTONIC，纳秒），用于延迟跟踪
 	/* 设备特定字段 */
 	unsigned long clock_g;
 	uint32_t period;
@@ -140,6 +147,7 @@ static inline u32 nuclei_rtc_readreg(struct nuclei_rtc *crtc, u32 reg)
 static irqreturn_t nuclei_rtc_irq_handler(int irq, void *id)
 {
     struct nuclei_rtc *crtc = id; 
+    u64 now = ktime_get_ns();
     
     if(crtc->irq_flag == 0) {
         crtc->irq_flag = 1;
@@ -151,7 +159,9 @@ static irqreturn_t nuclei_rtc_irq_handler(int irq, void *id)
 
     /* 更新中断计数和状态 */
     mutex_lock(&crtc->irq_lock);
-    crtc->irq_count++;
+    /* 单脉冲模式下一次中断代表多个周期 */
+    crtc->irq_count += crtc->oneshot_ticks ? crtc->oneshot_ticks : 1;
+    crtc->irq_ns = now;
     crtc->irq_pending = true;
     mutex_unlock(&crtc->irq_lock);
 
@@ -184,6 +194,10 @@ static int nuclei_rtc_open(struct inode *inode, struct file *file)
 	struct nuclei_rtc *crtc = container_of(inode->i_cdev, struct nuclei_rtc, cdev);
 	
 	file->private_data = crtc;
+
+	mutex_lock(&crtc->irq_lock);
+	crtc->reported_count = crtc->irq_count;
+	mutex_unlock(&crtc->irq_lock);
 	return 0;
 }
 
@@ -209,6 +223,7 @@ static ssize_t nuclei_rtc_read(struct file *file, char __user *buf, size_t count
 
 	mutex_lock(&crtc->irq_lock);
 	irq_count = crtc->irq_count;
+	crtc->reported_count = irq_count;
 	crtc->irq_pending = false;
 	mutex_unlock(&crtc->irq_lock);
 
@@ -232,6 +247,128 @@ static unsigned int nuclei_rtc_poll(struct file *file, poll_table *wait)
 	return mask;  //内核会匹配每个设备的返回值与用户设置的events，如果都不匹配，线程就会在poll()中阻塞，等待唤醒后，再次执行这个函数
 }
 
+/* 计算定时器周期（计数值），未通过RTC_VL_READ启动时也可使用 */
+static void nuclei_rtc_setup_period(struct nuclei_rtc *crtc)
+{
+	if (!crtc->period) {
+		nuclei_rtc_writereg(crtc, NUCLEI_PSC, PRESCALER);
+		crtc->clock_g = clk_get_rate(crtc->pclk);
+		crtc->period = crtc->clock_g / PRESCALER /1000000 * crtc->counter;
+	}
+}
+
+/*
+ * 停止计数器；若单脉冲正在进行，把已经走完的整周期计入irq_count，
+ * 返回当前周期内已走过的计数值。调用时持有irq_lock。
+ * 脉冲从周期内第pulse_rem个计数开始，网格位置为CNT加上该偏移；
+ * 周期模式下CNT本身就是周期内的位置。
+ */
+static u32 nuclei_rtc_stop_fold(struct nuclei_rtc *crtc)
+{
+	u32 cr1 = nuclei_rtc_readreg(crtc, NUCLEI_CR1);
+	u32 rem = 0;
+
+	if (cr1 & TIMER_CR1_CEN) {
+		u32 cnt = nuclei_rtc_readreg(crtc, NUCLEI_CNT);
+
+		if (crtc->oneshot_ticks) {
+			u32 pos = cnt + crtc->pulse_rem;
+
+			crtc->irq_count += pos / crtc->period;
+			rem = pos % crtc->period;
+		} else {
+			rem = cnt;
+		}
+	}
+	nuclei_rtc_writereg(crtc, NUCLEI_CR1, cr1 & ~(u32)TIMER_CR1_CEN);
+	return rem;
+}
+
+/* 重新装载ARR并启动计数器 */
+static void nuclei_rtc_start(struct nuclei_rtc *crtc, u32 arr, bool oneshot)
+{
+	u32 tmp;
+
+	nuclei_rtc_writereg(crtc, NUCLEI_ARR, arr);
+	/* generate an update event to load ARR and reset the counter */
+	tmp = nuclei_rtc_readreg(crtc, NUCLEI_EGR);
+	nuclei_rtc_writereg(crtc, NUCLEI_EGR, tmp|(uint32_t)BASIC_TIMER_EGR_UG);
+	/* clear the interrupt pending, the update event above must not count */
+	nuclei_rtc_writereg(crtc, NUCLEI_SR, (u32)~TIMER_INT_UP);
+	crtc->irq_flag = 1;
+	nuclei_rtc_writereg(crtc, NUCLEI_DIER, TIMER_INT_UP);
+
+	tmp = nuclei_rtc_readreg(crtc, NUCLEI_CR1) | BASIC_TIMER_CR1_AUTO_BUFFER_EN;
+	if (oneshot)
+		tmp |= TIMER_CR1_OPM;
+	else
+		tmp &= ~(u32)TIMER_CR1_OPM;
+	nuclei_rtc_writereg(crtc, NUCLEI_CR1, tmp|(uint32_t)BASIC_TIMER_CR1_CEN);
+}
+
+/* 字符设备ioctl：单脉冲（tickless）模式 */
+static long nuclei_rtc_chr_ioctl(struct file *file, unsigned int cmd, unsigned long arg)
+{
+	struct nuclei_rtc *crtc = file->private_data;
+	struct nuclei_rtc_oneshot req;
+	unsigned long target;
+	u32 rem, ticks;
+	u64 irq_ns;
+
+	switch (cmd) {
+	case NUCLEI_RTC_IOC_ONESHOT:
+		if (copy_from_user(&req, (void __user *)arg, sizeof(req)))
+			return -EFAULT;
+		if (req.ticks == 0 || req.reserved)
+			return -EINVAL;
+
+		mutex_lock(&crtc->irq_lock);
+		nuclei_rtc_setup_period(crtc);
+		rem = nuclei_rtc_stop_fold(crtc);
+		target = crtc->reported_count + req.ticks;
+
+		if ((long)(target - crtc->irq_count) <= 0) {
+			/* 截止时间已过：立即通知用户态 */
+			crtc->oneshot_ticks = 0;
+			crtc->irq_pending = true;
+			wake_up_interruptible(&crtc->wait_queue);
+		} else {
+			ticks = min_t(unsigned long, target - crtc->irq_count,
+				      nuclei_rtc_oneshot_max_ticks(crtc->period));
+			crtc->oneshot_ticks = ticks;
+			crtc->pulse_rem = rem;
+			nuclei_rtc_start(crtc, nuclei_rtc_oneshot_arr(crtc->period, ticks, rem), true);
+		}
+		req.count = crtc->reported_count;
+		mutex_unlock(&crtc->irq_lock);
+
+		if (copy_to_user((void __user *)arg, &req, sizeof(req)))
+			return -EFAULT;
+		return 0;
+
+	case NUCLEI_RTC_IOC_PERIODIC:
+		mutex_lock(&crtc->irq_lock);
+		nuclei_rtc_setup_period(crtc);
+		nuclei_rtc_stop_fold(crtc);
+		crtc->oneshot_ticks = 0;
+		nuclei_rtc_start(crtc, crtc->period - 1, false);
+		mutex_unlock(&crtc->irq_lock);
+		return 0;
+
+	case NUCLEI_RTC_IOC_IRQ_TIME:
+		/* 中断时间戳：用户态延迟跟踪的起点 */
+		mutex_lock(&crtc->irq_lock);
+		irq_ns = crtc->irq_ns;
+		mutex_unlock(&crtc->irq_lock);
+		if (copy_to_user((void __user *)arg, &irq_ns, sizeof(irq_ns)))
+			return -EFAULT;
+		return 0;
+
+	default:
+		return -ENOTTY;
+	}
+}
+
 /* 保留原有的RTC ioctl函数 */
 static int nuclei_rtc_ioctl(struct device *dev, unsigned int cmd,
 			     unsigned long arg)
@@ -249,9 +386,10 @@ static int nuclei_rtc_ioctl(struct device *dev, unsigned int cmd,
              /* generate an update event */
              tmp = nuclei_rtc_readreg(crtc, NUCLEI_EGR);
              nuclei_rtc_writereg(crtc, NUCLEI_EGR, tmp|(uint32_t)BASIC_TIMER_EGR_UG);
-             /* enable the auto reload shadow function */
-             tmp = nuclei_rtc_readreg(crtc, NUCLEI_CR1);
+             /* enable the auto reload shadow function, leave one pulse mode */
+             tmp = nuclei_rtc_readreg(crtc, NUCLEI_CR1) & ~(uint32_t)TIMER_CR1_OPM;
              nuclei_rtc_writereg(crtc, NUCLEI_CR1, tmp|(uint32_t)BASIC_TIMER_CR1_AUTO_BUFFER_EN);
+             crtc->oneshot_ticks = 0;
              /* clear the interrupt pending*/
 	        nuclei_rtc_writereg(crtc, NUCLEI_SR, (u32)~TIMER_INT_UP);
              /* enable irq */
@@ -286,6 +424,7 @@ static const struct file_operations nuclei_rtc_fops = {
 	.release = nuclei_rtc_release,
 	.read = nuclei_rtc_read,
 	.poll = nuclei_rtc_poll,
+	.unlocked_ioctl = nuclei_rtc_chr_ioctl,
 };
 
 static const struct rtc_class_ops nuclei_rtc_ops = {
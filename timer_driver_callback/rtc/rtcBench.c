@@ -0,0 +1,564 @@
+/*
+ * Dispatcher latency and throughput benchmark for the RTC service framework
+ *
+ * Runs rtcDriver.c unmodified on timer 0 with the emu tick backend. A pacer
+ * thread advances the emulated counter at the requested tick rate, so every
+ * tick goes through the real interrupt accounting, monitor wakeup, timing
+ * wheel and executor pool. Each run registers the requested number of
+ * services with a busy-loop callback and reports, over the measured window:
+ *   - wakeup-to-callback latency percentiles (tick handler entry to callback
+ *     entry, all services pooled)
+ *   - per-stage latency of service 0 from the trace ring (rtc_trace_*)
+ *   - missed ticks, overruns and executor drops
+ *   - CPU per tick, total and without the callbacks' own runtime
+ * With -m the tick rate is raised until the dispatcher stops keeping up, to
+ * find the highest sustainable rate. With -g it only checks that the emu
+ * one-pulse programming stays on the period grid across mode switches.
+ *
+ * Build and run:
+ *   gcc -O2 -o rtcbench rtcBench.c rtcDriver.c rtcExecutor.c rtcTimerWheel.c \
+ *       rtcTrace.c rtcTickShm.c rtcTickBackendEmu.c rtcTickBackendNuclei.c rtcTickBackendTimerfd.c -lpthread
+ *   ./rtcbench -s 16 -c 20 -r 2000
+ *   ./rtcbench -s 16 -c 20 -r 1000 -m
+ *   ./rtcbench -g
+ *
+ * Options:
+ *   -s <n>     Services registered (default 8)
+ *   -c <us>    Callback cost, busy loop in microseconds (default 10)
+ *   -i <n>     Service interval in ticks (default 1)
+ *   -r <hz>    Tick rate, the starting rate with -m (default 1000)
+ *   -t <ms>    Measured window per run (default 2000, 500 with -m)
+ *   -w <n>     Executor pool threads (default RTC_WORKER_POOL_SIZE)
+ *   -m         Search the highest sustainable tick rate
+ *   -g         Check the emu tick grid across one-pulse re-arms and exit
+ */
+#define _GNU_SOURCE
+#include "rtcDriver.h"
+#include "rtcTickBackend.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#define BENCH_TIMER 0                       /* Emulated timer driven by the pacer */
+#define BENCH_SPIN_PERIOD_NS 200000ULL      /* Shorter periods are paced by spinning, not sleeping */
+#define BENCH_WARMUP_MS 200                 /* Ticks before the measured window, in time */
+#define BENCH_SAMPLE_BUDGET (1U << 22)      /* Latency samples kept over all services */
+#define BENCH_SEARCH_STEPS 5                /* Bisection steps after the first unsustainable rate */
+#define BENCH_MISSED_PERMILLE 10            /* Missed ticks or overruns tolerated per thousand */
+#define BENCH_GRID_TIMER 1                  /* Emulated device used by the grid check */
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Benchmark parameters
+ */
+typedef struct {
+    int services;                   /* Services registered */
+    uint32_t cost_us;               /* Callback busy time */
+    int interval;                   /* Service interval in ticks */
+    uint32_t rate_hz;               /* Tick rate */
+    uint32_t window_ms;             /* Measured window */
+    int workers;                    /* Executor pool threads */
+} bench_config_t;
+
+/**
+ * @brief Per-service state; only the executor running the service writes it
+ */
+typedef struct {
+    char name[MAX_SERVICE_NAME_LEN];
+    uint64_t cost_ns;               /* Busy time per call */
+    uint64_t *samples;              /* Wakeup-to-callback latencies of the window */
+    uint32_t sample_cap;            /* Capacity of samples */
+    uint32_t sample_count;          /* Samples recorded, saturates at sample_cap */
+    uint64_t calls;                 /* Calls inside the window */
+} bench_service_t;
+
+/**
+ * @brief Result of one run
+ */
+typedef struct {
+    uint64_t ticks;                 /* Ticks generated in the window */
+    uint64_t elapsed_ns;            /* Window length */
+    uint64_t missed_ticks;          /* Ticks the monitor saw without their own wakeup */
+    uint64_t dispatches;            /* Jobs dispatched */
+    uint64_t overruns;              /* Firings that found the callback still running */
+    uint64_t dropped;               /* Jobs rejected by a full executor queue */
+    uint64_t calls;                 /* Callback calls */
+    uint64_t cpu_ns;                /* Process CPU, pacer excluded */
+    uint64_t callback_ns;           /* Callback busy time included in cpu_ns */
+    uint64_t p50_ns, p90_ns, p99_ns, p999_ns, max_ns;   /* Wakeup-to-callback latency */
+    rtc_trace_report_t trace;       /* Stages of service 0 */
+} bench_result_t;
+
+/* ========================= Global Variables ========================= */
+
+static atomic_int bench_measuring = 0;      /* Callbacks record samples */
+static atomic_int pacer_running = 0;        /* Pacer keeps generating ticks */
+static atomic_uint_least64_t pacer_ticks;   /* Ticks generated since the pacer started */
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief CLOCK_MONOTONIC time in nanoseconds
+ */
+static uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief CPU time of another thread in nanoseconds
+ */
+static uint64_t bench_thread_cpu_ns(pthread_t thread) {
+    struct timespec ts;
+    clockid_t cid;
+
+    if (pthread_getcpuclockid(thread, &cid) != 0 || clock_gettime(cid, &ts) != 0) {
+        return 0;
+    }
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief CPU time of the whole process in nanoseconds
+ */
+static uint64_t bench_process_cpu_ns(void) {
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ((uint64_t)ru.ru_utime.tv_sec + (uint64_t)ru.ru_stime.tv_sec) * 1000000000ULL +
+           ((uint64_t)ru.ru_utime.tv_usec + (uint64_t)ru.ru_stime.tv_usec) * 1000ULL;
+}
+
+/**
+ * @brief Service callback: record the latency from the tick handler, then burn the cost
+ */
+static void bench_callback(void *ctx, const rtc_tick_info_t *info) {
+    bench_service_t *bs = ctx;
+    uint64_t start = bench_now_ns();
+
+    if (atomic_load_explicit(&bench_measuring, memory_order_relaxed)) {
+        if (bs->sample_count < bs->sample_cap) {
+            bs->samples[bs->sample_count++] = start - info->timestamp_ns;
+        }
+        bs->calls++;
+    }
+    while (bench_now_ns() - start < bs->cost_ns) {
+        /* Busy loop standing in for the service's work */
+    }
+    rtc_trace_mark();
+}
+
+/**
+ * @brief Pacer thread: advance the emulated counter one period per tick at the configured rate
+ *
+ * Ticks the pacer falls behind on are delivered together, as a late
+ * interrupt would be, so the generated tick count follows wall time.
+ */
+static void* bench_pacer_thread(void *arg) {
+    const bench_config_t *cfg = arg;
+    uint64_t period_ns = 1000000000ULL / cfg->rate_hz;
+    uint64_t next = bench_now_ns() + period_ns;
+
+    while (atomic_load_explicit(&pacer_running, memory_order_relaxed)) {
+        uint64_t now = bench_now_ns();
+
+        if (now < next) {
+            if (period_ns >= BENCH_SPIN_PERIOD_NS) {
+                struct timespec ts = {.tv_sec = (time_t)(next / 1000000000ULL),
+                                      .tv_nsec = (long)(next % 1000000000ULL)};
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+            }
+            continue;
+        }
+
+        uint64_t due = (now - next) / period_ns + 1;
+        rtc_tick_emu_advance(BENCH_TIMER, due * RTC_TICK_EMU_PERIOD);
+        atomic_fetch_add_explicit(&pacer_ticks, due, memory_order_relaxed);
+        next += due * period_ns;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Wait until the pacer has generated the given tick count
+ */
+static void bench_wait_ticks(uint64_t target) {
+    while (atomic_load_explicit(&pacer_ticks, memory_order_relaxed) < target) {
+        usleep(1000);
+    }
+}
+
+/**
+ * @brief Advance the grid check device and compare the count it reports
+ *
+ * @param expect Count read_count() must return, 0 if no tick may be pending
+ * @return int 0 if the device behaved as expected
+ */
+static int bench_grid_step(rtc_device_t *dev, uint64_t counts, unsigned long expect, const char *what) {
+    unsigned long count = 0;
+
+    rtc_tick_emu_advance(BENCH_GRID_TIMER, counts);
+    int ret = dev->backend->read_count(dev, &count);
+    if (expect ? (ret != 0 || count != expect) : (ret == 0)) {
+        printf("grid check failed at %s: read_count=%d count=%lu, expected %lu\n", what, ret, count, expect);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Check that one-pulse deadlines stay on the period grid
+ *
+ * Switches a periodic emu device to one-pulse mode part way into a period,
+ * then re-arms a pulse that itself started part way into a period; every
+ * deadline must still fall on a multiple of RTC_TICK_EMU_PERIOD.
+ */
+static int bench_check_grid(void) {
+    rtc_device_t dev = {.fd = -1, .id = BENCH_GRID_TIMER, .backend = &rtc_tick_backend_emu};
+    unsigned long base;
+    int ret = -1;
+
+    if (dev.backend->open(&dev) != 0) {
+        printf("grid check: cannot open emu device %d\n", BENCH_GRID_TIMER);
+        return -1;
+    }
+
+    /* Periodic to one-pulse at t=290: tick 7 is due at t=700 */
+    if (bench_grid_step(&dev, 290, 2, "periodic ticks") != 0 ||
+        dev.backend->oneshot(&dev, 5, &base) != 0 ||
+        bench_grid_step(&dev, 409, 0, "t=699 after periodic switch") != 0 ||
+        bench_grid_step(&dev, 1, 7, "t=700 after periodic switch") != 0) {
+        goto out;
+    }
+
+    /* Tick 11 re-armed at t=850, then again from that pulse at t=970: due at t=1100 */
+    if (dev.backend->oneshot(&dev, 4, &base) != 0) {
+        goto out;
+    }
+    rtc_tick_emu_advance(BENCH_GRID_TIMER, 150);
+    if (dev.backend->oneshot(&dev, 4, &base) != 0) {
+        goto out;
+    }
+    rtc_tick_emu_advance(BENCH_GRID_TIMER, 120);
+    if (dev.backend->oneshot(&dev, 4, &base) != 0 ||
+        bench_grid_step(&dev, 129, 0, "t=1099 after mid-pulse re-arm") != 0 ||
+        bench_grid_step(&dev, 1, 11, "t=1100 after mid-pulse re-arm") != 0) {
+        goto out;
+    }
+
+    printf("grid check passed\n");
+    ret = 0;
+out:
+    dev.backend->close(&dev);
+    return ret;
+}
+
+/**
+ * @brief qsort comparator for latencies
+ */
+static int bench_cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted samples, in units of 1/10000
+ */
+static uint64_t bench_percentile(const uint64_t *sorted, uint64_t count, uint32_t per10k) {
+    uint64_t rank = (count * per10k + 9999) / 10000;
+
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+/**
+ * @brief Pool the latency samples of all services into the result percentiles
+ */
+static int bench_summarize(bench_service_t *svcs, int count, bench_result_t *res) {
+    uint64_t total = 0;
+    uint64_t *all;
+
+    for (int i = 0; i < count; i++) {
+        total += svcs[i].sample_count;
+        res->calls += svcs[i].calls;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    all = malloc(sizeof(uint64_t) * total);
+    if (!all) {
+        return -1;
+    }
+    total = 0;
+    for (int i = 0; i < count; i++) {
+        memcpy(&all[total], svcs[i].samples, sizeof(uint64_t) * svcs[i].sample_count);
+        total += svcs[i].sample_count;
+    }
+    qsort(all, total, sizeof(uint64_t), bench_cmp_u64);
+    res->p50_ns = bench_percentile(all, total, 5000);
+    res->p90_ns = bench_percentile(all, total, 9000);
+    res->p99_ns = bench_percentile(all, total, 9900);
+    res->p999_ns = bench_percentile(all, total, 9990);
+    res->max_ns = all[total - 1];
+    free(all);
+    return 0;
+}
+
+/**
+ * @brief Sum dispatcher counters over the registered services
+ */
+static void bench_service_totals(bench_service_t *svcs, int count, uint64_t *dispatches,
+                                 uint64_t *overruns, uint64_t *runtime_ns) {
+    rtc_service_stats_t st;
+
+    *dispatches = *overruns = *runtime_ns = 0;
+    for (int i = 0; i < count; i++) {
+        if (rtc_get_service_stats(BENCH_TIMER, svcs[i].name, &st) == 0) {
+            *dispatches += st.dispatches;
+            *overruns += st.overruns;
+            *runtime_ns += st.runtime_mean_ns * st.runs;
+        }
+    }
+}
+
+/**
+ * @brief Run one configuration from rtc_init() to rtc_cleanup()
+ *
+ * @return int 0 on success, -1 if the framework could not be set up
+ */
+static int bench_run(const bench_config_t *cfg, bench_result_t *res) {
+    bench_service_t *svcs = calloc((size_t)cfg->services, sizeof(*svcs));
+    uint32_t cap = BENCH_SAMPLE_BUDGET / (uint32_t)cfg->services;
+    rtc_timer_stats_t t0, t1;
+    rtc_pool_stats_t p0, p1;
+    uint64_t d0, d1, o0, o1, r0, r1;
+    uint64_t tick0, tick1, ns0, ns1, cpu0, cpu1, pacer0, pacer1;
+    pthread_t pacer;
+    int ret = -1;
+
+    memset(res, 0, sizeof(*res));
+    if (!svcs) {
+        return -1;
+    }
+    for (int i = 0; i < cfg->services; i++) {
+        svcs[i].samples = malloc(sizeof(uint64_t) * cap);
+        if (!svcs[i].samples) {
+            goto out;
+        }
+        svcs[i].sample_cap = cap;
+        svcs[i].cost_ns = (uint64_t)cfg->cost_us * 1000ULL;
+        snprintf(svcs[i].name, sizeof(svcs[i].name), "bench%d", i);
+    }
+
+    if (rtc_set_tick_backend(BENCH_TIMER, &rtc_tick_backend_emu, 1000000U / cfg->rate_hz) != 0 ||
+        rtc_set_worker_pool_size(cfg->workers) != 0 || rtc_init() != 0) {
+        goto out;
+    }
+    for (int i = 0; i < cfg->services; i++) {
+        if (rtc_register_service_ctx(BENCH_TIMER, svcs[i].name, cfg->interval, bench_callback, &svcs[i]) != 0) {
+            goto cleanup;
+        }
+    }
+    rtc_set_service_trace(BENCH_TIMER, svcs[0].name, 1);
+
+    atomic_store(&pacer_ticks, 0);
+    atomic_store(&pacer_running, 1);
+    if (pthread_create(&pacer, NULL, bench_pacer_thread, (void *)cfg) != 0) {
+        atomic_store(&pacer_running, 0);
+        goto cleanup;
+    }
+
+    /* Warm up, then measure over a window of deltas */
+    bench_wait_ticks((uint64_t)cfg->rate_hz * BENCH_WARMUP_MS / 1000 + 1);
+    rtc_get_timer_stats(BENCH_TIMER, &t0);
+    rtc_get_pool_stats(&p0);
+    bench_service_totals(svcs, cfg->services, &d0, &o0, &r0);
+    tick0 = atomic_load(&pacer_ticks);
+    ns0 = bench_now_ns();
+    pacer0 = bench_thread_cpu_ns(pacer);
+    cpu0 = bench_process_cpu_ns();
+    atomic_store(&bench_measuring, 1);
+
+    usleep(cfg->window_ms * 1000U);
+
+    atomic_store(&bench_measuring, 0);
+    cpu1 = bench_process_cpu_ns();
+    pacer1 = bench_thread_cpu_ns(pacer);
+    ns1 = bench_now_ns();
+    tick1 = atomic_load(&pacer_ticks);
+    bench_service_totals(svcs, cfg->services, &d1, &o1, &r1);
+    rtc_get_pool_stats(&p1);
+    rtc_get_timer_stats(BENCH_TIMER, &t1);
+    rtc_get_service_trace(BENCH_TIMER, svcs[0].name, &res->trace);
+
+    atomic_store(&pacer_running, 0);
+    pthread_join(pacer, NULL);
+
+    res->ticks = tick1 - tick0;
+    res->elapsed_ns = ns1 - ns0;
+    res->missed_ticks = t1.missed_ticks - t0.missed_ticks;
+    res->dispatches = d1 - d0;
+    res->overruns = o1 - o0;
+    res->dropped = p1.dropped - p0.dropped;
+    /* The pacer stands in for the interrupt; its CPU is not the dispatcher's */
+    res->cpu_ns = (cpu1 - cpu0 > pacer1 - pacer0) ? (cpu1 - cpu0) - (pacer1 - pacer0) : 0;
+    res->callback_ns = r1 - r0;
+    ret = bench_summarize(svcs, cfg->services, res);
+
+cleanup:
+    rtc_cleanup();
+out:
+    for (int i = 0; i < cfg->services; i++) {
+        free(svcs[i].samples);
+    }
+    free(svcs);
+    return ret;
+}
+
+/**
+ * @brief Check that the dispatcher kept up with the ticks of a run
+ */
+static int bench_sustainable(const bench_config_t *cfg, const bench_result_t *res) {
+    uint64_t expected = res->elapsed_ns * cfg->rate_hz / 1000000000ULL;
+
+    return res->ticks * 100 >= expected * 99 &&    /* Pacer delivered the rate */
+           res->missed_ticks * 1000 <= res->ticks * BENCH_MISSED_PERMILLE &&
+           res->overruns * 1000 <= res->dispatches * BENCH_MISSED_PERMILLE &&
+           res->dropped == 0;
+}
+
+/**
+ * @brief Print one run
+ */
+static void bench_print(const bench_config_t *cfg, const bench_result_t *res) {
+    static const char *stage_names[RTC_TRACE_STAGES] = {
+        "irq->wakeup", "wakeup->tick", "tick->dispatch", "dispatch->start", "start->publish", "total"
+    };
+    uint64_t ticks = res->ticks ? res->ticks : 1;
+
+    printf("rate=%uHz services=%d cost=%uus interval=%d workers=%d: %s\n",
+           cfg->rate_hz, cfg->services, cfg->cost_us, cfg->interval, cfg->workers,
+           bench_sustainable(cfg, res) ? "sustained" : "NOT sustained");
+    printf("  ticks=%llu missed=%llu dispatches=%llu calls=%llu overruns=%llu dropped=%llu\n",
+           (unsigned long long)res->ticks, (unsigned long long)res->missed_ticks,
+           (unsigned long long)res->dispatches, (unsigned long long)res->calls,
+           (unsigned long long)res->overruns, (unsigned long long)res->dropped);
+    printf("  wakeup->callback latency(us) p50=%.1f p90=%.1f p99=%.1f p99.9=%.1f max=%.1f\n",
+           res->p50_ns / 1e3, res->p90_ns / 1e3, res->p99_ns / 1e3, res->p999_ns / 1e3, res->max_ns / 1e3);
+    printf("  cpu/tick(us) total=%.2f dispatcher=%.2f\n",
+           res->cpu_ns / 1e3 / ticks,
+           (res->cpu_ns > res->callback_ns ? res->cpu_ns - res->callback_ns : 0) / 1e3 / ticks);
+    printf("  %s stages over %u traced runs:\n", "bench0", res->trace.records);
+    for (int i = 0; i < RTC_TRACE_STAGES; i++) {
+        const rtc_trace_stage_stats_t *st = &res->trace.stage[i];
+        printf("    %-16s p50=%.1f p90=%.1f p99=%.1f max=%.1f\n", stage_names[i],
+               st->p50_ns / 1e3, st->p90_ns / 1e3, st->p99_ns / 1e3, st->max_ns / 1e3);
+    }
+}
+
+/**
+ * @brief Raise the tick rate until it is no longer sustained, then bisect
+ */
+static int bench_search(bench_config_t *cfg) {
+    bench_result_t res;
+    uint32_t good = 0;
+    uint32_t bad = 0;
+
+    /* Double until the first unsustainable rate */
+    while (!bad) {
+        if (bench_run(cfg, &res) != 0) {
+            return -1;
+        }
+        bench_print(cfg, &res);
+        if (bench_sustainable(cfg, &res)) {
+            good = cfg->rate_hz;
+            if (cfg->rate_hz > 1000000U / 2) {
+                break;      /* Emulated period cannot go below 1us */
+            }
+            cfg->rate_hz *= 2;
+        } else {
+            bad = cfg->rate_hz;
+        }
+    }
+
+    for (int step = 0; bad && step < BENCH_SEARCH_STEPS && bad - good > 1; step++) {
+        cfg->rate_hz = good + (bad - good) / 2;
+        if (bench_run(cfg, &res) != 0) {
+            return -1;
+        }
+        bench_print(cfg, &res);
+        if (bench_sustainable(cfg, &res)) {
+            good = cfg->rate_hz;
+        } else {
+            bad = cfg->rate_hz;
+        }
+    }
+
+    if (good) {
+        printf("max sustainable tick rate: %uHz\n", good);
+    } else {
+        printf("max sustainable tick rate: below the starting rate\n");
+    }
+    return 0;
+}
+
+static void bench_usage(const char *prog) {
+    printf("Usage: %s [-s services] [-c cost_us] [-i interval] [-r rate_hz] [-t window_ms] [-w workers] [-m] [-g]\n", prog);
+}
+
+int main(int argc, char *argv[]) {
+    bench_config_t cfg = {
+        .services = 8,
+        .cost_us = 10,
+        .interval = 1,
+        .rate_hz = 1000,
+        .window_ms = 0,
+        .workers = RTC_WORKER_POOL_SIZE,
+    };
+    int search = 0;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "s:c:i:r:t:w:mgh")) != -1) {
+        switch (opt) {
+            case 's': cfg.services = atoi(optarg); break;
+            case 'c': cfg.cost_us = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'i': cfg.interval = atoi(optarg); break;
+            case 'r': cfg.rate_hz = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 't': cfg.window_ms = (uint32_t)strtoul(optarg, NULL, 10); break;
+            case 'w': cfg.workers = atoi(optarg); break;
+            case 'm': search = 1; break;
+            case 'g': return bench_check_grid() == 0 ? 0 : 1;
+            default:
+                bench_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (cfg.services <= 0 || cfg.services > RTC_SERVICE_CHUNKS * RTC_SERVICE_CHUNK_SIZE ||
+        cfg.interval <= 0 || cfg.rate_hz == 0 || cfg.rate_hz > 1000000U ||
+        cfg.workers <= 0 || cfg.workers > RTC_WORKER_POOL_MAX) {
+        bench_usage(argv[0]);
+        return 1;
+    }
+    if (cfg.window_ms == 0) {
+        cfg.window_ms = search ? 500 : 2000;
+    }
+
+    if (search) {
+        return bench_search(&cfg) == 0 ? 0 : 1;
+    }
+
+    bench_result_t res;
+    if (bench_run(&cfg, &res) != 0) {
+        printf("benchmark setup failed\n");
+        return 1;
+    }
+    bench_print(&cfg, &res);
+    return 0;
+}
@@ -6,36 +6,177 @@ static void rtcUsage(){
     printf("Usage:\n");
     printf("dfe rtc disable_irq <rtc number>\n");
     printf("dfe rtc enable_irq <rtc number>\n");
+    printf("dfe rtc stats <timer number> [service name]\n");
+    printf("dfe rtc trace <timer number> <service name> [on|off]\n");
+}
+
+static void rtcPrintServiceStats(const rtc_service_stats_t *st)
+{
+    printf("%-20s interval=%d phase=%d dispatches=%llu runs=%llu overruns=%llu overrun_dropped=%llu late_dropped=%llu\n",
+           st->name, st->interval, st->phase,
+           (unsigned long long)st->dispatches, (unsigned long long)st->runs,
+           (unsigned long long)st->overruns, (unsigned long long)st->overrun_dropped,
+           (unsigned long long)st->late_dropped);
+    if (st->strand[0] != '\0') {
+        printf("%-20s strand=%s\n", "", st->strand);
+    }
+    if (st->slack) {
+        printf("%-20s slack=%d early=%llu\n", "", st->slack, (unsigned long long)st->slack_early);
+    }
+    if (st->budget_ns) {
+        printf("%-20s budget=%lluus over_budget=%llu\n", "",
+               (unsigned long long)(st->budget_ns / 1000), (unsigned long long)st->budget_overruns);
+    }
+    printf("%-20s runtime(us) last=%llu min=%llu max=%llu mean=%llu\n", "",
+           (unsigned long long)(st->runtime_last_ns / 1000), (unsigned long long)(st->runtime_min_ns / 1000),
+           (unsigned long long)(st->runtime_max_ns / 1000), (unsigned long long)(st->runtime_mean_ns / 1000));
+    printf("%-20s start latency(us):", "");
+    for (int i = 0; i < RTC_LATENCY_HIST_BUCKETS; i++) {
+        if (st->latency_hist[i]) {
+            printf(" <%u:%u", 2U << i, st->latency_hist[i]);
+        }
+    }
+    printf("\n");
+}
+
+static void rtcStats(int argc, char *argv[])
+{
+    char *end = NULL;
+    long timer_id = strtol(argv[3], &end, 10);
+    rtc_timer_stats_t timer_stats;
+    rtc_timer_drift_t drift;
+    rtc_pool_stats_t pool_stats;
+    rtc_timer_utilization_t util;
+
+    if (*argv[3] == '\0' || *end != '\0' || rtc_get_timer_stats((int)timer_id, &timer_stats) != 0) {
+        printf("invalid timer number\n");
+        return;
+    }
+
+    /* Single service */
+    if (argc == 5) {
+        rtc_service_stats_t st;
+        if (rtc_get_service_stats((int)timer_id, argv[4], &st) != 0) {
+            printf("service %s not found on timer%ld\n", argv[4], timer_id);
+            return;
+        }
+        rtcPrintServiceStats(&st);
+        return;
+    }
+
+    printf("timer%ld: ticks=%llu wakeups=%llu missed=%llu coalesced=%llu max_gap=%u irq_count=%lu\n",
+           timer_id, (unsigned long long)timer_stats.ticks, (unsigned long long)timer_stats.wakeups,
+           (unsigned long long)timer_stats.missed_ticks, (unsigned long long)timer_stats.coalesced_wakeups,
+           timer_stats.max_gap, timer_stats.last_irq_count);
+    if (rtc_get_timer_drift((int)timer_id, &drift) == 0 && drift.tick_seconds > 0.0) {
+        printf("timer%ld: tick=%.9fs nominal=%.9fs drift=%.1fppm windows=%llu\n",
+               timer_id, drift.tick_seconds, drift.nominal_seconds, drift.drift_ppm,
+               (unsigned long long)drift.windows);
+    }
+    if (rtc_get_timer_utilization((int)timer_id, &util) == 0) {
+        printf("timer%ld: cpu(permille) declared=%u measured=%u admitted=%u ceiling=%u over_budget=%d\n",
+               timer_id, util.declared_permille, util.measured_permille, util.admitted_permille,
+               util.ceiling_permille, util.over_budget);
+    }
+    if (rtc_get_pool_stats(&pool_stats) == 0) {
+        printf("pool: threads=%d depth=%u max_depth=%u dispatched=%llu dropped=%llu start_latency(us) max=%llu mean=%llu\n",
+               pool_stats.pool_size, pool_stats.queue_depth, pool_stats.queue_depth_max,
+               (unsigned long long)pool_stats.dispatched, (unsigned long long)pool_stats.dropped,
+               (unsigned long long)(pool_stats.start_latency_max_ns / 1000),
+               (unsigned long long)(pool_stats.started ? pool_stats.start_latency_total_ns / pool_stats.started / 1000 : 0));
+    }
+
+    int max_count = RTC_SERVICE_CHUNKS * RTC_SERVICE_CHUNK_SIZE;
+    rtc_service_stats_t *all = malloc(sizeof(rtc_service_stats_t) * max_count);
+    if (!all) {
+        printf("out of memory\n");
+        return;
+    }
+    int count = rtc_get_all_service_stats((int)timer_id, all, max_count);
+    for (int i = 0; i < count; i++) {
+        rtcPrintServiceStats(&all[i]);
+    }
+    free(all);
+}
+
+static void rtcTrace(int argc, char *argv[])
+{
+    static const char *stage_names[RTC_TRACE_STAGES] = {
+        "irq->wakeup", "wakeup->tick", "tick->dispatch", "dispatch->start", "start->publish", "total"
+    };
+    char *end = NULL;
+    long timer_id = strtol(argv[3], &end, 10);
+    rtc_trace_report_t report;
+
+    if (*argv[3] == '\0' || *end != '\0') {
+        printf("invalid timer number\n");
+        return;
+    }
+
+    /* Switch tracing */
+    if (argc == 6) {
+        if (strcmp(argv[5], "on") && strcmp(argv[5], "off")) {
+            rtcUsage();
+            return;
+        }
+        rtc_set_service_trace((int)timer_id, argv[4], !strcmp(argv[5], "on"));
+        return;
+    }
+
+    if (rtc_get_service_trace((int)timer_id, argv[4], &report) != 0) {
+        printf("service %s not found on timer%ld\n", argv[4], timer_id);
+        return;
+    }
+    printf("%s: %u traced runs\n", argv[4], report.records);
+    for (int i = 0; i < RTC_TRACE_STAGES; i++) {
+        const rtc_trace_stage_stats_t *st = &report.stage[i];
+        printf("%-16s samples=%u latency(us) p50=%llu p90=%llu p99=%llu max=%llu\n",
+               stage_names[i], st->samples,
+               (unsigned long long)(st->p50_ns / 1000), (unsigned long long)(st->p90_ns / 1000),
+               (unsigned long long)(st->p99_ns / 1000), (unsigned long long)(st->max_ns / 1000));
+    }
 }
 
 void rtcCmd(int argc, char *argv[])
 {
     char *cmd = argv[2];
 
+    if (argc >= 4 && !strcmp(cmd, "stats")) {
+        if (argc > 5) {
+            rtcUsage();
+            return;
+        }
+        rtcStats(argc, argv);
+        return;
+    }
+
+    if (argc >= 5 && !strcmp(cmd, "trace")) {
+        if (argc > 6) {
+            rtcUsage();
+            return;
+        }
+        rtcTrace(argc, argv);
+        return;
+    }
+
     if (argc != 4) {
         rtcUsage();
         return;
     }
 
+    char *end;
+    long rtc_num = strtol(argv[3], &end, 10);
+
+    if (*argv[3] == '\0' || *end != '\0' || rtc_num < 0 || rtc_num >= RTC_TIMER_MAX) {
+        printf("invalid rtc number\n");
+        return;
+    }
+
     if(!strcmp(cmd, "disable_irq")) {
-        if(strcmp(argv[3], "0") == 0) {
-            rtc_disable_irq(0);
-        } else if(strcmp(argv[3], "1") == 0) {
-            rtc_disable_irq(1);
-        } else {
-            printf("invalid rtc number\n");
-            return;
-        }
+        rtc_disable_irq((int)rtc_num);
     }
     else if(!strcmp(cmd, "enable_irq")) {
-        if(strcmp(argv[3], "0") == 0) {
-            rtc_enable_irq(0);
-        } else if(strcmp(argv[3], "1") == 0) {
-            rtc_enable_irq(1);
-        } else {
-            printf("invalid rtc number\n");
-            return;
-        }
+        rtc_enable_irq((int)rtc_num);
     }
 }
 
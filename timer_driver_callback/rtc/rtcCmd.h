@@ -8,7 +8,7 @@ extern "C" {
 /**
  * @brief Initialize RTC CLI commands
  *
- * @note This registers RTC-related CLI commands, including enable_irq and disable_irq
+ * @note This registers RTC-related CLI commands, including enable_irq, disable_irq, stats and trace
  */
 void rtcCmdInit(void);
 
@@ -18,7 +18,7 @@ void rtcCmdInit(void);
  * @param argc Argument count
  * @param argv Argument vector
  *
- * @note Handles RTC-related CLI options: enable_irq and disable_irq
+ * @note Handles RTC-related CLI options: enable_irq, disable_irq, stats and trace
  */
 void rtcCmd(int argc, char *argv[]);
 
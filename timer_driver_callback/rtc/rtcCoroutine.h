@@ -0,0 +1,85 @@
+#ifndef __RTC_COROUTINE_H__
+#define __RTC_COROUTINE_H__
+
+#include <stdint.h>
+
+/*
+ * Stackless coroutines for RTC services
+ *
+ * A coroutine service is a function that the driver calls again at the
+ * point it last awaited, in the style of protothreads: the resume point is
+ * a line number kept in rtc_coro_t and the body is one switch statement.
+ * Waiting returns to the executor, so a waiting coroutine holds no thread.
+ *
+ *     static rtc_coro_status_t sensor_coro(rtc_coro_t *co, void *ctx, const rtc_tick_info_t *info) {
+ *         sensor_t *s = ctx;
+ *
+ *         RTC_CORO_BEGIN(co);
+ *         sensor_start_conversion(s);
+ *         RTC_CORO_AWAIT_TICKS(co, 2);
+ *         s->value = sensor_read(s);
+ *         RTC_CORO_END(co);
+ *     }
+ *
+ * Rules of the switch-based implementation:
+ *   - locals do not survive an await; keep state in the context
+ *   - at most one await per source line
+ *   - no await inside a nested switch statement
+ */
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Result of one coroutine step
+ */
+typedef enum {
+    RTC_CORO_DONE = 0,              /* Finished; runs again from the start on the next period */
+    RTC_CORO_WAIT_TICKS,            /* Resume after co->wait_ticks ticks */
+    RTC_CORO_WAIT_FD                /* Resume once co->wait_fd is readable */
+} rtc_coro_status_t;
+
+/**
+ * @brief Coroutine state, kept by the driver in the service slot
+ */
+typedef struct {
+    int line;                       /* Resume point, 0 at the start */
+    rtc_coro_status_t wait;         /* What the coroutine is waiting for */
+    uint32_t wait_ticks;            /* Ticks requested by RTC_CORO_AWAIT_TICKS */
+    int wait_fd;                    /* Descriptor requested by RTC_CORO_AWAIT_FD */
+    uint64_t resume_tick;           /* Tick at which a tick wait ends */
+} rtc_coro_t;
+
+/* ========================= Macro Definitions ========================= */
+
+/* Start of the coroutine body */
+#define RTC_CORO_BEGIN(co) \
+    switch ((co)->line) { case 0:
+
+/* Suspend for n ticks (at least one) without holding a thread */
+#define RTC_CORO_AWAIT_TICKS(co, n) \
+    do { \
+        (co)->line = __LINE__; \
+        (co)->wait_ticks = (uint32_t)(n); \
+        return RTC_CORO_WAIT_TICKS; \
+        case __LINE__:; \
+    } while (0)
+
+/* Suspend until fd is readable; the coroutine does not read it */
+#define RTC_CORO_AWAIT_FD(co, fd) \
+    do { \
+        (co)->line = __LINE__; \
+        (co)->wait_fd = (fd); \
+        return RTC_CORO_WAIT_FD; \
+        case __LINE__:; \
+    } while (0)
+
+/* Suspend until the next tick */
+#define RTC_CORO_YIELD(co) RTC_CORO_AWAIT_TICKS(co, 1)
+
+/* End of the coroutine body; the next period starts again at RTC_CORO_BEGIN */
+#define RTC_CORO_END(co) \
+    } \
+    (co)->line = 0; \
+    return RTC_CORO_DONE
+
+#endif /* __RTC_COROUTINE_H__ */
@@ -1,537 +1,3118 @@
+#define _GNU_SOURCE
 #include "rtcDriver.h"
+#include "rtcExecutor.h"
+#include "rtcTickBackend.h"
+#include "rtcTrace.h"
+#include "rtcTickShm.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <fcntl.h>
-#include <poll.h>
 #include <errno.h>
 #include <string.h>
 #include <pthread.h>
 #include <sys/time.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sched.h>
 #include <time.h>
 
 /* ========================= Global Variables ========================= */
 
-/* RTC device management */
-static rtc_device_t rtc_devices[2] = {
-    {.fd = -1, .device_path = NUCLEI_RTC_CHR_DEV0, .is_initialized = 0},
-    {.fd = -1, .device_path = NUCLEI_RTC_CHR_DEV1, .is_initialized = 0}
-};
+/* RTC device management; entries get their defaults on first use (rtc_mutex) */
+static rtc_device_t rtc_devices[RTC_TIMER_MAX];
+static atomic_int rtc_timer_count = 0;          /* Timers discovered by rtc_init(), 0 when not initialized */
+
+#if RTC_MAX_TICK_SOURCES < RTC_TIMER_MAX
+#error "RTC_MAX_TICK_SOURCES must cover every timer device"
+#endif
 
 /* Interrupt monitoring thread related */
 static pthread_t monitor_thread;
-static int monitor_running = 0;
+static atomic_int monitor_running = 0;
+static int monitor_epfd = -1;                   /* epoll set of tick sources and control eventfd */
+static atomic_int monitor_ctl_fd = -1;          /* eventfd waking the monitor for control messages */
+static rtc_thread_attr_t monitor_attr;          /* Monitor scheduling attributes (rtc_mutex) */
+
+/* epoll tag of the control eventfd; tick sources are tagged with their table index */
+#define RTC_CTL_EVENT_ID UINT32_MAX
+
+/* epoll tag flag of a descriptor awaited by a coroutine; the low bits hold its slot index */
+#define RTC_CORO_EVENT_FLAG 0x80000000U
+
+/**
+ * @brief Tick source watched by the monitor thread (monitor thread only)
+ */
+typedef struct {
+    int fd;                         /* Source descriptor, -1 when unused */
+    int timer_id;                   /* Timer driven by the source */
+    rtc_device_t *dev;              /* Device whose backend reads the tick count */
+    rtc_device_t ext;               /* Device record of a source added with rtc_add_tick_source() */
+    int irq_count_valid;            /* last_irq_count holds a count read from the source */
+    unsigned long last_irq_count;   /* Last cumulative count read from the source */
+    uint64_t armed_tick;            /* Wheel tick the one-shot is programmed for, 0 if none */
+} rtc_tick_source_t;
+
+/* Longest one-shot the monitor programs; bounds the catch-up loop of an idle wheel */
+#define RTC_TICKLESS_MAX_TICKS (RTC_WHEEL_ROOT_SIZE * RTC_WHEEL_LEVEL_SIZE)
+
+static rtc_tick_source_t tick_sources[RTC_MAX_TICK_SOURCES];
+
+/**
+ * @brief Control message types handled by the monitor thread
+ */
+typedef enum {
+    RTC_CTL_ADD_SOURCE = 0,         /* Start watching a tick source */
+    RTC_CTL_REMOVE_SOURCE           /* Stop watching a tick source */
+} rtc_ctl_type_t;
+
+/**
+ * @brief Control message; lives on the requester's stack until done
+ */
+typedef struct rtc_ctl_msg {
+    rtc_ctl_type_t type;            /* Message type */
+    int fd;                         /* Tick source descriptor */
+    int timer_id;                   /* Timer for RTC_CTL_ADD_SOURCE */
+    int result;                     /* 0 on success, -1 on failure */
+    int done;                       /* Set by the monitor once applied */
+    struct rtc_ctl_msg *next;       /* Next queued message */
+} rtc_ctl_msg_t;
+
+static pthread_mutex_t ctl_mutex = PTHREAD_MUTEX_INITIALIZER;  /* Protects the control queue */
+static pthread_cond_t ctl_cond;                                 /* Signals applied messages (CLOCK_MONOTONIC) */
+static pthread_once_t ctl_cond_once = PTHREAD_ONCE_INIT;
+static rtc_ctl_msg_t *ctl_queue = NULL;                         /* Pending control messages */
+
+/* Cross-process tick page; created by rtc_init(), written by the monitor only */
+static char tick_shm_name[64];                      /* Object name, empty when not publishing (rtc_mutex) */
+static rtc_tick_shm_t *tick_shm = NULL;
+
+#if RTC_TICK_SHM_TIMERS < RTC_TIMER_MAX
+#error "RTC_TICK_SHM_TIMERS must cover RTC_TIMER_MAX"
+#endif
+
+/* Virtual time; the caller of rtc_virtual_run() stands in for the monitor and the executors */
+static int virtual_timers = 0;                      /* Simulated timers for the next rtc_init(), 0 for real time (rtc_mutex) */
+static atomic_int virtual_time = 0;                 /* Set while initialized in virtual time */
+static atomic_uint_least64_t virtual_now_ns = 0;    /* Simulated time since rtc_init() */
+static pthread_mutex_t virtual_mutex = PTHREAD_MUTEX_INITIALIZER;  /* One rtc_virtual_run() at a time */
+
+/* Callback executor pool */
+static rtc_executor_t worker_pool;
+static int worker_pool_size = RTC_WORKER_POOL_SIZE;
+static int worker_pool_running = 0;
+
+/**
+ * @brief Named serial executor shared by several services
+ */
+typedef struct rtc_strand {
+    char name[MAX_SERVICE_NAME_LEN];    /* Strand name, empty for a free entry */
+    rtc_executor_t *executor;           /* Single-thread executor running the strand's jobs */
+} rtc_strand_t;
+
+/* Named strands; an entry is only changed while no service points at it (rtc_mutex) */
+static rtc_strand_t strands[RTC_STRAND_MAX];
 
 /* Mutexes */
-static pthread_mutex_t rtc_mutex = PTHREAD_MUTEX_INITIALIZER;  /* Protects service list operations */
+static pthread_mutex_t rtc_mutex = PTHREAD_MUTEX_INITIALIZER;  /* Protects init, cleanup and configuration */
+
+/* Per-timer timing wheels */
+static rtc_timer_t rtc_timers[RTC_TIMER_MAX];
+
+/* Service slot table, grown one chunk at a time */
+static _Atomic(timer_service_t *) service_chunks[RTC_SERVICE_CHUNKS];
+
+/* Name lookup of active services, chained through hash_next */
+static pthread_mutex_t registry_mutex = PTHREAD_MUTEX_INITIALIZER;  /* Protects service_hash and name uniqueness */
+static timer_service_t *service_hash[RTC_SERVICE_HASH_SIZE];
+
+/* Latency tracing */
+static rtc_trace_ring_t trace_ring;                 /* Records of traced runs, all services */
+static atomic_int trace_services = 0;               /* Services with tracing enabled, all timers */
+static __thread rtc_trace_record_t *trace_current;  /* Record of the traced run on this executor */
+
+/**
+ * @brief Pipeline stage as copied at registration
+ */
+typedef struct {
+    char name[MAX_SERVICE_NAME_LEN];    /* Stage name */
+    rtc_service_callback_t callback;    /* Stage function */
+    void *ctx;                          /* Context passed to the stage */
+    uint32_t decimation;                /* Run on every Nth pipeline run */
+} rtc_pipeline_entry_t;
+
+/**
+ * @brief Stages of a pipeline service, owned by its slot
+ */
+typedef struct rtc_pipeline {
+    int stage_count;                                    /* Number of stages */
+    uint64_t runs;                                      /* Pipeline runs (executor holding the service only) */
+    rtc_pipeline_entry_t stages[RTC_PIPELINE_MAX_STAGES];/* Stages in execution order */
+} rtc_pipeline_t;
+
+/* Service slot phases (low two bits of timer_service_t.state) */
+#define SERVICE_FREE        0U
+#define SERVICE_CLAIMED     1U
+#define SERVICE_ACTIVE      2U
+#define SERVICE_RETIRING    3U
+#define SERVICE_PHASE(state)        ((state) & 3U)
+#define SERVICE_GEN(state)          ((state) >> 2)
+#define SERVICE_STATE(gen, phase)   (((gen) << 2) | (phase))
 
-/* Timer service arrays */
-static timer_service_t services_timer0[MAX_SERVICES];
-static timer_service_t services_timer1[MAX_SERVICES];
+/* Service slot references (timer_service_t.refs) */
+#define SERVICE_REF_WHEEL   1U      /* Held until the monitor drops the service from the wheel */
+#define SERVICE_REF_RUN     2U      /* Held while the callback is queued or running */
+#define SERVICE_REF_OWED    4U      /* Runs owed after the current call, counted from this bit up */
 
 /* ========================= Private Function Declarations ========================= */
 static void* rtc_irq_monitor_thread(void *arg);
-static void* task_thread_func(void* arg);
-static void rtc_timer_tick_handler(void);
-static void rtc_timer_tick_handler2(void);
+static void task_thread_func(void* arg);
+static void rtc_dispatch_service(timer_service_t* service);
+static void rtc_dispatch_batch(timer_service_t* batch);
+static void rtc_timer_tick_handler(int timer_id, uint32_t elapsed, uint32_t missed);
+static void rtc_service_fire(timer_service_t* service, uint64_t tick);
+static void rtc_service_watch_fd(timer_service_t* service, int fd);
+static void rtc_monitor_coro_ready(uint32_t slot_index);
+static int rtc_service_overrun(rtc_timer_t* timer, timer_service_t* service, uint64_t tick);
+static void rtc_timer_account_irq(rtc_tick_source_t* source, unsigned long irq_count);
+static void rtc_timer_measure_period(rtc_timer_t* timer, uint64_t now_ns);
+static void rtc_timer_rearm(rtc_tick_source_t* source);
+static void rtc_monitor_rearm_all(void);
+static void rtc_monitor_notify(void);
+static void rtc_monitor_handle_control(void);
+static int rtc_monitor_request(rtc_ctl_msg_t *msg);
+static int rtc_monitor_open(void);
+static void rtc_monitor_close(void);
+static void close_rtc_devices(void);
+static rtc_device_t* rtc_device_get(int timer_id);
+static int rtc_timer_valid(int timer_id);
+static int rtc_discover_devices(void);
+static rtc_executor_t* service_executor_create(const rtc_thread_attr_t *attr);
+static void service_executor_destroy(rtc_executor_t *ex);
+static void rtc_timer_apply_changes(rtc_timer_t* timer);
 static int init_timer_services(void);
 static void cleanup_timer_services(void);
-static timer_service_t* get_timer_services(int timer_id);
+static timer_service_t* service_slot_claim(void);
+static void service_slot_release(timer_service_t* service, unsigned int ref);
+static void service_slot_free(timer_service_t* service);
+static void service_post_change(rtc_timer_t* timer, timer_service_t* service);
+static timer_service_t* service_find(int timer_id, const char *name, unsigned int *state);
+static timer_service_t** service_hash_bucket(int timer_id, const char *name);
+static timer_service_t* service_hash_lookup(int timer_id, const char *name);
+static void service_legacy_callback(void *ctx, const rtc_tick_info_t *info);
+static int service_register(int timer_id, const char *name, int interval, int phase,
+                            rtc_service_callback_t callback, void *ctx,
+                            void (*callback_func)(void), rtc_service_resched_t resched_func,
+                            rtc_coro_func_t coro_func, rtc_pipeline_t *pipeline,
+                            const rtc_thread_attr_t *attr, uint32_t budget_us);
+static void service_pipeline_run(void *ctx, const rtc_tick_info_t *info);
+static void service_resched_callback(void *ctx, const rtc_tick_info_t *info);
+static uint32_t service_coro_step(void *ctx, const rtc_tick_info_t *info);
+static timer_service_t* service_slot_at(uint32_t slot_index);
+static int service_auto_phase(int timer_id, int interval);
+static void service_stats_snapshot(timer_service_t* service, rtc_service_stats_t *stats);
+static void timer_utilization_sum(int timer_id, const timer_service_t *skip, rtc_timer_utilization_t *util);
+static int timer_admit(int timer_id, const char *name, const timer_service_t *skip, uint32_t extra_permille);
+static uint64_t rtc_virtual_tick_ns(int timer_id);
+static void rtc_virtual_advance(int count, uint64_t now_ns);
+
+/**
+ * @brief Time base of tick timestamps: the simulated clock in virtual time
+ */
+static inline uint64_t rtc_clock_ns(void) {
+    if (atomic_load_explicit(&virtual_time, memory_order_relaxed)) {
+        return atomic_load_explicit(&virtual_now_ns, memory_order_relaxed);
+    }
+    return rtc_monotonic_ns();
+}
 
 /* ========================= Thread Related Functions ========================= */
 
 /**
- * @brief Task thread function - executes callback and then exits
+ * @brief Run a service callback and record its runtime
+ *
+ * @return uint64_t Total runtime of the runs
+ */
+static uint64_t service_run(timer_service_t* service, const rtc_tick_info_t *info, uint32_t runs) {
+    rtc_service_counters_t* stats = &service->stats;
+    uint64_t first_ns = rtc_monotonic_ns();
+    uint64_t start_ns = first_ns;
+    
+    /* Run once per owed firing; stop if the service was unregistered after dispatch */
+    for (uint32_t run = 0; run < runs; run++) {
+        if (SERVICE_PHASE(atomic_load_explicit(&service->state, memory_order_acquire)) != SERVICE_ACTIVE) {
+            break;
+        }
+        service->callback(service->ctx, info);
+        
+        /* Runtime statistics; only this executor writes them while it holds the service */
+        uint64_t end_ns = rtc_monotonic_ns();
+        if (trace_current) {
+            /* Only the first run is traced; it ends here unless the callback marked it */
+            if (!trace_current->stamp[RTC_TRACE_PUBLISH]) {
+                trace_current->stamp[RTC_TRACE_PUBLISH] =
+                    atomic_load_explicit(&virtual_time, memory_order_relaxed) ? rtc_clock_ns() : end_ns;
+            }
+            trace_current = NULL;
+        }
+        uint64_t runtime = end_ns - start_ns;
+        start_ns = end_ns;
+        atomic_store_explicit(&stats->runtime_last_ns, runtime, memory_order_relaxed);
+        atomic_fetch_add_explicit(&stats->runtime_total_ns, runtime, memory_order_relaxed);
+        if (runtime < atomic_load_explicit(&stats->runtime_min_ns, memory_order_relaxed)) {
+            atomic_store_explicit(&stats->runtime_min_ns, runtime, memory_order_relaxed);
+        }
+        if (runtime > atomic_load_explicit(&stats->runtime_max_ns, memory_order_relaxed)) {
+            atomic_store_explicit(&stats->runtime_max_ns, runtime, memory_order_relaxed);
+        }
+        atomic_fetch_add_explicit(&stats->runs, 1, memory_order_relaxed);
+        
+        uint64_t budget = atomic_load_explicit(&service->budget_ns, memory_order_relaxed);
+        if (budget && runtime > budget) {
+            atomic_fetch_add_explicit(&stats->budget_overruns, 1, memory_order_relaxed);
+            if (!atomic_exchange_explicit(&service->budget_warned, 1, memory_order_relaxed)) {
+                printf("Service '%s' on timer%d exceeded its CPU budget: %lluus > %lluus\n",
+                       service->service_name, service->timer_id,
+                       (unsigned long long)(runtime / 1000), (unsigned long long)(budget / 1000));
+            }
+        }
+    }
+    
+    return start_ns - first_ns;
+}
+
+/**
+ * @brief Finish a call: raise the overrun alarm, then take owed runs or drop the running reference
+ *
+ * @return uint32_t Owed runs taken (the running reference is kept), 0 once released
+ */
+static uint32_t service_run_finish(timer_service_t* service, uint64_t sequence, uint64_t runtime_ns) {
+    unsigned int events = atomic_exchange_explicit(&service->overrun_events, 0, memory_order_relaxed);
+    
+    if (events) {
+        rtc_overrun_alarm_t alarm = atomic_load_explicit(&service->overrun_alarm, memory_order_acquire);
+        
+        if (alarm) {
+            rtc_overrun_event_t event = {
+                .name = service->service_name,
+                .timer_id = service->timer_id,
+                .policy = atomic_load_explicit(&service->overrun_policy, memory_order_relaxed),
+                .sequence = sequence,
+                .runtime_ns = runtime_ns,
+                .overruns = events,
+            };
+            alarm(atomic_load_explicit(&service->overrun_ctx, memory_order_relaxed), &event);
+        }
+    }
+    
+    /* Owed runs and the running reference share one word, so none is lost to a racing tick */
+    unsigned int refs = atomic_load_explicit(&service->refs, memory_order_acquire);
+    for (;;) {
+        uint32_t owed = refs / SERVICE_REF_OWED;
+        unsigned int next = owed ? (refs & (SERVICE_REF_OWED - 1)) : (refs & ~SERVICE_REF_RUN);
+        
+        if (atomic_compare_exchange_weak_explicit(&service->refs, &refs, next,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            if (owed) {
+                return owed;
+            }
+            if (next == 0) {
+                service_slot_free(service);  /* Unregistered while running */
+            }
+            return 0;
+        }
+    }
+}
+
+/**
+ * @brief Task function - executes callback on an executor thread
+ */
+static void task_thread_func(void* arg) {
+    timer_service_t* service = (timer_service_t*)arg;
+    
+    rtc_service_counters_t* stats = &service->stats;
+    uint64_t start_ns = rtc_clock_ns();
+    uint32_t owed;
+    
+    /* Start latency relative to the tick that queued the job */
+    uint64_t latency_us = (start_ns - service->tick_ns) / 1000;
+    int bucket = (latency_us < 2) ? 0 : 63 - __builtin_clzll(latency_us);
+    if (bucket >= RTC_LATENCY_HIST_BUCKETS) {
+        bucket = RTC_LATENCY_HIST_BUCKETS - 1;
+    }
+    atomic_fetch_add_explicit(&stats->latency_hist[bucket], 1, memory_order_relaxed);
+    
+    rtc_tick_info_t info = {
+        .timestamp_ns = service->tick_ns,
+        .sequence = service->tick_seq,
+        .missed_ticks = service->tick_missed,
+        .skipped = service->tick_skipped,
+        .overruns = atomic_exchange_explicit(&service->overrun_lost, 0, memory_order_relaxed),
+        .tick_seconds = rtc_get_tick_seconds(service->timer_id),
+    };
+    
+    /* A traced job carries the stamps taken by the monitor up to its dispatch */
+    rtc_trace_record_t trace;
+    int traced = (service->trace_dispatch_ns != 0);
+    if (traced) {
+        memset(&trace, 0, sizeof(trace));
+        trace.owner = service;
+        trace.generation = SERVICE_GEN(atomic_load_explicit(&service->state, memory_order_relaxed));
+        trace.stamp[RTC_TRACE_IRQ] = service->trace_irq_ns;
+        trace.stamp[RTC_TRACE_WAKEUP] = service->trace_wakeup_ns;
+        trace.stamp[RTC_TRACE_TICK] = service->tick_ns;
+        trace.stamp[RTC_TRACE_DISPATCH] = service->trace_dispatch_ns;
+        trace.stamp[RTC_TRACE_START] = start_ns;
+        service->trace_dispatch_ns = 0;
+        trace_current = &trace;
+    }
+    uint64_t runtime = service_run(service, &info, service->run_count);
+    if (traced) {
+        trace_current = NULL;
+        if (trace.stamp[RTC_TRACE_PUBLISH]) {
+            rtc_trace_ring_push(&trace_ring, &trace);
+        }
+    }
+    
+    /* Run firings that came due meanwhile before handing the service back */
+    while ((owed = service_run_finish(service, info.sequence, runtime)) != 0) {
+        info.timestamp_ns = rtc_clock_ns();
+        info.sequence = atomic_load_explicit(&service->owed_seq, memory_order_relaxed);
+        info.missed_ticks = 0;
+        info.skipped = 0;
+        info.overruns = owed + atomic_exchange_explicit(&service->overrun_lost, 0, memory_order_relaxed);
+        atomic_fetch_add_explicit(&stats->dispatches, 1, memory_order_relaxed);
+        runtime = service_run(service, &info, 1);
+    }
+}
+
+/**
+ * @brief Queue a service callback to the executor pool
+ *
+ * @note The caller already holds the running reference; it is dropped again
+ *       if the job cannot be queued.
+ */
+static void rtc_dispatch_service(timer_service_t* service) {
+    /* In virtual time the clock stands still until the callback returns */
+    if (atomic_load_explicit(&virtual_time, memory_order_relaxed)) {
+        task_thread_func(service);
+        return;
+    }
+    
+    /* No job of the service is in flight here, so moving it to a strand is safe */
+    rtc_strand_t *strand = atomic_load_explicit(&service->strand, memory_order_acquire);
+    rtc_executor_t *ex = strand ? strand->executor : service->executor ? service->executor : &worker_pool;
+    
+    if (rtc_executor_submit(ex, task_thread_func, service) != 0) {
+        printf("Failed to queue task for service %s: executor queue full\n", 
+               service->service_name);
+        service->trace_dispatch_ns = 0;
+        service_slot_release(service, SERVICE_REF_RUN);
+    }
+}
+
+/**
+ * @brief Task function - runs a batch of slack services one after another
  */
-static void* task_thread_func(void* arg) {
+static void task_batch_func(void* arg) {
     timer_service_t* service = (timer_service_t*)arg;
     
-    if (service && service->callback_func) {
-        service->callback_func();
+    while (service) {
+        /* The service may be dispatched again once its run releases it */
+        timer_service_t* next = service->batch_next;
+        
+        task_thread_func(service);
+        service = next;
+    }
+}
+
+/**
+ * @brief Queue slack services that came due in the same wakeup as one pool job
+ *
+ * @note Each service already holds its running reference; all are dropped
+ *       again if the job cannot be queued.
+ */
+static void rtc_dispatch_batch(timer_service_t* batch) {
+    if (atomic_load_explicit(&virtual_time, memory_order_relaxed)) {
+        task_batch_func(batch);
+        return;
+    }
+    if (!batch->batch_next) {
+        rtc_dispatch_service(batch);
+        return;
+    }
+    
+    if (rtc_executor_submit(&worker_pool, task_batch_func, batch) != 0) {
+        printf("Failed to queue batch of slack services: executor queue full\n");
+        while (batch) {
+            timer_service_t* next = batch->batch_next;
+            
+            batch->trace_dispatch_ns = 0;
+            service_slot_release(batch, SERVICE_REF_RUN);
+            batch = next;
+        }
+    }
+}
+
+/**
+ * @brief Slack in effect, kept below the period so windows never overlap (monitor thread only)
+ */
+static uint64_t service_slack(const timer_service_t* service) {
+    uint64_t slack = service->slack_ticks;
+    
+    return (service->threshold > 0 && slack >= (uint64_t)service->threshold) ? (uint64_t)service->threshold - 1 : slack;
+}
+
+/**
+ * @brief Apply a slack change: keep the timer's slack list and the wheel deadline in step (monitor thread only)
+ */
+static void service_slack_apply(rtc_timer_t* timer, timer_service_t* service, uint32_t slack) {
+    if (service->slack_ticks && !slack) {
+        timer_service_t** link = &timer->slack_list;
+        
+        while (*link && *link != service) {
+            link = &(*link)->slack_next;
+        }
+        if (*link) {
+            *link = service->slack_next;
+        }
+        service->slack_next = NULL;
+    } else if (!service->slack_ticks && slack) {
+        service->slack_next = timer->slack_list;
+        timer->slack_list = service;
+    }
+    service->slack_ticks = slack;
+    
+    /* The wheel holds the end of the window */
+    if (service->wheel_node.next) {
+        rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+        rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+    }
+}
+
+/**
+ * @brief Apply pending registration changes to a timer's wheel
+ *
+ * @note Runs on the IRQ monitor thread, the only owner of the wheel.
+ */
+static void rtc_timer_apply_changes(rtc_timer_t* timer) {
+    timer_service_t* service = atomic_exchange_explicit(&timer->pending, NULL, memory_order_acquire);
+    
+    while (service) {
+        timer_service_t* next = service->pending_next;
+        
+        /* Re-arm before reading the state so later changes are queued again */
+        atomic_store(&service->pending, 0);
+        
+        unsigned int phase = SERVICE_PHASE(atomic_load(&service->state));
+        if (phase == SERVICE_ACTIVE) {
+            uint64_t now = rtc_wheel_now(&timer->wheel);
+            int interval = atomic_load(&service->interval);
+            uint32_t slack = (uint32_t)atomic_load(&service->slack);
+            uint64_t resched;
+            int wait_fd;
+            
+            if (slack != service->slack_ticks) {
+                service_slack_apply(timer, service, slack);
+            }
+            if ((wait_fd = atomic_exchange(&service->coro_wait_fd, -1)) >= 0) {
+                /* Coroutine awaits a descriptor: leave the wheel until it is readable */
+                rtc_service_watch_fd(service, wait_fd);
+            } else if (service->coro_watch_fd >= 0) {
+                /* Off the wheel; other changes apply when the descriptor is ready */
+            } else if (!service->wheel_node.next) {
+                /* First expiry: the next tick matching the service's phase */
+                uint64_t first = now + 1;
+                uint64_t offset = (uint64_t)(atomic_load(&service->phase) % interval);
+                service->threshold = interval;
+                service->next_due = first + (offset + interval - first % (uint64_t)interval) % (uint64_t)interval;
+                rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+            } else if ((resched = atomic_exchange(&service->resched_due, 0)) != 0) {
+                /* Callback asked for its next run; the period resumes from there */
+                service->threshold = interval;
+                service->next_due = (resched > now) ? resched : now + 1;
+                atomic_store(&service->phase, (int)(service->next_due % (uint64_t)interval));
+                rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+                rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+            } else if (interval != service->threshold) {
+                /* New period measured from the last on-period expiry */
+                uint64_t last = service->next_due - (uint64_t)service->threshold;
+                service->threshold = interval;
+                service->next_due = (last + interval > now) ? last + interval : now + 1;
+                atomic_store(&service->phase, (int)(service->next_due % (uint64_t)interval));
+                rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+                rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+            }
+        } else if (phase == SERVICE_RETIRING &&
+                   (atomic_load(&service->refs) & SERVICE_REF_WHEEL)) {
+            if (service->coro_watch_fd >= 0) {
+                epoll_ctl(monitor_epfd, EPOLL_CTL_DEL, service->coro_watch_fd, NULL);
+                service->coro_watch_fd = -1;
+            }
+            if (service->slack_ticks) {
+                service_slack_apply(timer, service, 0);
+            }
+            rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+            service_slot_release(service, SERVICE_REF_WHEEL);
+        } else if (phase == SERVICE_RETIRING && atomic_load(&service->refs) == 0 && service->executor) {
+            /* Last reference gone: stop the dedicated thread, then free the slot */
+            service_executor_destroy(service->executor);
+            service->executor = NULL;
+            service_slot_free(service);
+        }
+        
+        service = next;
+    }
+}
+
+/**
+ * @brief Timer tick handler function
+ *
+ * Advances the timer's wheel by the number of ticks elapsed since the last
+ * wakeup and dispatches only the services expiring in that span. Services
+ * keep their schedule even when interrupts coalesced; the catch-up policy
+ * decides how many times a service that expired more than once, or late,
+ * runs. The path takes no locks: running state is an atomic reference, and
+ * a service whose previous callback is still running is retried on the
+ * following tick.
+ */
+static void rtc_timer_tick_handler(int timer_id, uint32_t elapsed, uint32_t missed) {
+    rtc_timer_t* timer = &rtc_timers[timer_id];
+    timer_service_t* due = NULL;
+    rtc_wheel_node_t expired;
+    rtc_wheel_node_t* node;
+    uint64_t tick = rtc_wheel_now(&timer->wheel);
+    uint64_t tick_ns = rtc_clock_ns();
+    
+    rtc_timer_apply_changes(timer);
+    
+    /* Collect every expiry in the elapsed span, keeping each service on its period */
+    for (uint32_t i = 0; i < elapsed; i++) {
+        rtc_wheel_list_init(&expired);
+        tick = rtc_wheel_advance(&timer->wheel, &expired);
+        
+        while ((node = rtc_wheel_list_pop(&expired)) != NULL) {
+            timer_service_t* service = RTC_WHEEL_ENTRY(node, timer_service_t, wheel_node);
+            
+            if (SERVICE_PHASE(atomic_load_explicit(&service->state, memory_order_acquire)) != SERVICE_ACTIVE) {
+                continue;  /* Unregistered: released when its change is applied */
+            }
+            
+            if (service->due_count++ == 0) {
+                service->due_next = due;
+                due = service;
+            }
+            
+            /* A slack service expires at the end of its window; the firing belongs
+             * to the window start. An overrun retry expires before next_due and
+             * leaves the period alone. */
+            uint64_t slack = service_slack(service);
+            if (tick >= service->next_due + slack) {
+                service->due_tick = tick - slack;
+                service->next_due = service->due_tick + service->threshold;
+            } else {
+                service->due_tick = tick;
+            }
+            rtc_wheel_add(&timer->wheel, node, service->next_due + slack);
+        }
+    }
+    
+    /* Slack services whose window is open ride along with anything dispatched now */
+    if (due) {
+        for (timer_service_t* service = timer->slack_list; service; service = service->slack_next) {
+            if (service->due_count || !service->wheel_node.next || service->next_due > tick ||
+                SERVICE_PHASE(atomic_load_explicit(&service->state, memory_order_acquire)) != SERVICE_ACTIVE ||
+                (atomic_load_explicit(&service->refs, memory_order_relaxed) & SERVICE_REF_RUN)) {
+                continue;
+            }
+            service->due_count = 1;
+            service->due_next = due;
+            due = service;
+            service->due_tick = service->next_due;
+            service->next_due += service->threshold;
+            rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+            rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+            atomic_fetch_add_explicit(&service->stats.slack_early, 1, memory_order_relaxed);
+        }
+    }
+    
+    /* Dispatch due services according to their catch-up policy */
+    timer_service_t* batch = NULL;
+    timer_service_t** batch_tail = &batch;
+    while (due) {
+        timer_service_t* service = due;
+        uint32_t expiries = service->due_count;
+        int on_time = (tick - service->due_tick <= service_slack(service));
+        uint32_t runs = 1;
+        
+        due = service->due_next;
+        service->due_next = NULL;
+        service->due_count = 0;
+        
+        switch (atomic_load_explicit(&service->catchup_policy, memory_order_relaxed)) {
+            case RTC_CATCHUP_SKIP:
+                if (!on_time) {
+                    /* Only late firings: wait for the next deadline */
+                    atomic_fetch_add_explicit(&service->stats.late_dropped, expiries, memory_order_relaxed);
+                    continue;
+                }
+                atomic_fetch_add_explicit(&service->stats.late_dropped, expiries - 1, memory_order_relaxed);
+                break;
+                
+            case RTC_CATCHUP_REPLAY:
+                runs = atomic_load_explicit(&service->catchup_max, memory_order_relaxed);
+                if (runs == 0 || runs > expiries) {
+                    runs = expiries;
+                }
+                atomic_fetch_add_explicit(&service->stats.late_dropped, expiries - runs, memory_order_relaxed);
+                break;
+                
+            default:
+                atomic_fetch_add_explicit(&service->stats.late_dropped, expiries - 1, memory_order_relaxed);
+                break;
+        }
+        
+        /* Take the running reference to prevent re-entrancy */
+        if ((atomic_fetch_or_explicit(&service->refs, SERVICE_REF_RUN, memory_order_acq_rel) & SERVICE_REF_RUN) &&
+            rtc_service_overrun(timer, service, tick) != 0) {
+            continue;
+        }
+        
+        service->run_count = runs;
+        service->tick_ns = tick_ns;
+        service->tick_seq = service->due_tick;
+        service->tick_missed = missed;
+        service->tick_skipped = expiries - runs;
+        if (atomic_load_explicit(&service->trace, memory_order_relaxed)) {
+            service->trace_irq_ns = timer->irq_ns;
+            service->trace_wakeup_ns = timer->wakeup_ns;
+            service->trace_dispatch_ns = rtc_clock_ns();
+        }
+        atomic_fetch_add_explicit(&service->stats.dispatches, 1, memory_order_relaxed);
+        
+        /* Slack services bound for the shared pool share one job */
+        if (service->slack_ticks && !service->executor &&
+            !atomic_load_explicit(&service->strand, memory_order_relaxed)) {
+            service->batch_next = NULL;
+            *batch_tail = service;
+            batch_tail = &service->batch_next;
+            continue;
+        }
+        rtc_dispatch_service(service);
+    }
+    if (batch) {
+        rtc_dispatch_batch(batch);
+    }
+}
+
+/**
+ * @brief Apply the overrun policy to a firing that found the callback still running
+ *
+ * @return int 0 if the callback returned meanwhile and the running reference
+ *         is now held, -1 if the firing was deferred or dropped
+ */
+static int rtc_service_overrun(rtc_timer_t* timer, timer_service_t* service, uint64_t tick) {
+    rtc_overrun_policy_t policy = atomic_load_explicit(&service->overrun_policy, memory_order_relaxed);
+    unsigned int refs = atomic_load_explicit(&service->refs, memory_order_acquire);
+    
+    if (policy == RTC_OVERRUN_QUEUE_ONE || policy == RTC_OVERRUN_COALESCE) {
+        for (;;) {
+            unsigned int next;
+            
+            if (!(refs & SERVICE_REF_RUN)) {
+                next = refs | SERVICE_REF_RUN;  /* Returned meanwhile: dispatch normally */
+            } else if (policy == RTC_OVERRUN_QUEUE_ONE && refs >= SERVICE_REF_OWED) {
+                policy = RTC_OVERRUN_SKIP;      /* One run already owed */
+                break;
+            } else {
+                /* Queue-one keeps the first firing, coalesce the latest */
+                if (policy == RTC_OVERRUN_COALESCE || refs < SERVICE_REF_OWED) {
+                    atomic_store_explicit(&service->owed_seq, tick, memory_order_relaxed);
+                }
+                next = refs + SERVICE_REF_OWED;
+            }
+            if (atomic_compare_exchange_weak_explicit(&service->refs, &refs, next,
+                                                      memory_order_acq_rel, memory_order_acquire)) {
+                if (!(refs & SERVICE_REF_RUN)) {
+                    return 0;
+                }
+                break;
+            }
+        }
+    }
+    
+    atomic_fetch_add_explicit(&service->stats.overruns, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&service->overrun_events, 1, memory_order_relaxed);
+    
+    switch (policy) {
+        case RTC_OVERRUN_SKIP:
+            atomic_fetch_add_explicit(&service->overrun_lost, 1, memory_order_relaxed);
+            atomic_fetch_add_explicit(&service->stats.overrun_dropped, 1, memory_order_relaxed);
+            break;
+            
+        case RTC_OVERRUN_QUEUE_ONE:
+        case RTC_OVERRUN_COALESCE:
+            break;  /* Owed to the running call */
+            
+        default:
+            /* Retry on the next tick, keeping the period */
+            if (tick + 1 < service->next_due) {
+                rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+                rtc_wheel_add(&timer->wheel, &service->wheel_node, tick + 1);
+            }
+            break;
+    }
+    return -1;
+}
+
+/**
+ * @brief Dispatch a service outside its wheel expiries (monitor thread only)
+ *
+ * A call still returning keeps the running reference; the firing is then
+ * owed to it, as with RTC_OVERRUN_QUEUE_ONE.
+ */
+static void rtc_service_fire(timer_service_t* service, uint64_t tick) {
+    unsigned int refs = atomic_load_explicit(&service->refs, memory_order_acquire);
+    
+    for (;;) {
+        if (refs & SERVICE_REF_RUN) {
+            atomic_store_explicit(&service->owed_seq, tick, memory_order_relaxed);
+            if (atomic_compare_exchange_weak_explicit(&service->refs, &refs, refs + SERVICE_REF_OWED,
+                                                      memory_order_acq_rel, memory_order_acquire)) {
+                return;
+            }
+        } else if (atomic_compare_exchange_weak_explicit(&service->refs, &refs, refs | SERVICE_REF_RUN,
+                                                         memory_order_acq_rel, memory_order_acquire)) {
+            break;
+        }
+    }
+    
+    service->run_count = 1;
+    service->tick_ns = rtc_clock_ns();
+    service->tick_seq = tick;
+    service->tick_missed = 0;
+    service->tick_skipped = 0;
+    atomic_fetch_add_explicit(&service->stats.dispatches, 1, memory_order_relaxed);
+    rtc_dispatch_service(service);
+}
+
+/**
+ * @brief Take a coroutine service off the wheel and watch the descriptor it awaits (monitor thread only)
+ */
+static void rtc_service_watch_fd(timer_service_t* service, int fd) {
+    rtc_timer_t* timer = &rtc_timers[service->timer_id];
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = RTC_CORO_EVENT_FLAG | service->slot_index};
+    
+    if (epoll_ctl(monitor_epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+        /* Resume on the next period rather than never */
+        perror("Failed to watch coroutine descriptor");
+        atomic_store(&service->coro_fd_ready, 1);
+        return;
+    }
+    rtc_wheel_remove(&timer->wheel, &service->wheel_node);
+    service->coro_watch_fd = fd;
+}
+
+/**
+ * @brief Resume a coroutine whose awaited descriptor became readable (monitor thread only)
+ */
+static void rtc_monitor_coro_ready(uint32_t slot_index) {
+    timer_service_t* service = service_slot_at(slot_index);
+    
+    if (!service || service->coro_watch_fd < 0) {
+        return;  /* Retired in this batch */
+    }
+    epoll_ctl(monitor_epfd, EPOLL_CTL_DEL, service->coro_watch_fd, NULL);
+    service->coro_watch_fd = -1;
+    if (SERVICE_PHASE(atomic_load_explicit(&service->state, memory_order_acquire)) != SERVICE_ACTIVE) {
+        return;
+    }
+    
+    /* Back on the wheel with the period restarting now */
+    rtc_timer_t* timer = &rtc_timers[service->timer_id];
+    uint64_t now = rtc_wheel_now(&timer->wheel);
+    service->threshold = atomic_load(&service->interval);
+    service->next_due = now + (uint64_t)service->threshold;
+    atomic_store(&service->phase, (int)(service->next_due % (uint64_t)service->threshold));
+    rtc_wheel_add(&timer->wheel, &service->wheel_node, service->next_due + service_slack(service));
+    
+    atomic_store(&service->coro_fd_ready, 1);
+    rtc_service_fire(service, now);
+}
+
+/**
+ * @brief Turn a cumulative kernel interrupt count into elapsed ticks
+ *
+ * The nuclei driver only wakes readers once per pending flag, so a delayed
+ * monitor sees several interrupts as one wakeup. The difference between
+ * successive counts is the real number of ticks to account. A tickless
+ * source is expected to cover every tick up to its programmed deadline;
+ * only ticks beyond it are missed.
+ */
+static void rtc_timer_account_irq(rtc_tick_source_t* source, unsigned long irq_count) {
+    rtc_timer_t* timer = &rtc_timers[source->timer_id];
+    uint32_t elapsed = 1;
+    uint32_t expected = 1;
+    uint32_t missed;
+    
+    if (source->irq_count_valid) {
+        if (irq_count == source->last_irq_count) {
+            return;  /* No new interrupt */
+        }
+        /* A count that went backwards means the device was reset: count one tick */
+        if (irq_count > source->last_irq_count) {
+            unsigned long delta = irq_count - source->last_irq_count;
+            elapsed = (delta > UINT32_MAX) ? UINT32_MAX : (uint32_t)delta;
+        }
+    }
+    source->irq_count_valid = 1;
+    source->last_irq_count = irq_count;
+    atomic_store_explicit(&timer->last_irq_count, irq_count, memory_order_relaxed);
+    
+    if (source->armed_tick) {
+        uint64_t now = rtc_wheel_now(&timer->wheel);
+        
+        expected = (source->armed_tick > now + 1) ? (uint32_t)(source->armed_tick - now) : 1;
+        source->armed_tick = 0;
+    }
+    missed = (elapsed > expected) ? elapsed - expected : 0;
+    
+    atomic_fetch_add_explicit(&timer->wakeups, 1, memory_order_relaxed);
+    uint64_t ticks = atomic_fetch_add_explicit(&timer->ticks, elapsed, memory_order_relaxed) + elapsed;
+    uint64_t now_ns = rtc_monotonic_ns();
+    rtc_timer_measure_period(timer, now_ns);
+    if (tick_shm) {
+        /* Other processes hear of the tick before local services run */
+        rtc_tick_shm_publish(tick_shm, source->timer_id, ticks, now_ns,
+                             atomic_load_explicit(&timer->tick_ps, memory_order_relaxed));
+    }
+    if (missed) {
+        atomic_fetch_add_explicit(&timer->missed_ticks, missed, memory_order_relaxed);
+        atomic_fetch_add_explicit(&timer->coalesced_wakeups, 1, memory_order_relaxed);
+        if (elapsed > atomic_load_explicit(&timer->max_gap, memory_order_relaxed)) {
+            atomic_store_explicit(&timer->max_gap, elapsed, memory_order_relaxed);
+        }
+    }
+    
+    rtc_timer_tick_handler(source->timer_id, elapsed, missed);
+}
+
+/**
+ * @brief Update the measured tick period of a timer (monitor thread only)
+ *
+ * The period follows from the ticks accounted between two wakeups a window
+ * apart, so lateness of the wakeups in between cancels out. Each completed
+ * window moves the published estimate by 1/RTC_DRIFT_SMOOTHING; until the
+ * first one completes the running window is published as is.
+ */
+static void rtc_timer_measure_period(rtc_timer_t* timer, uint64_t now_ns) {
+    uint64_t ticks = atomic_load_explicit(&timer->ticks, memory_order_relaxed);
+    uint64_t windows = atomic_load_explicit(&timer->drift_windows, memory_order_relaxed);
+    
+    if (!timer->drift_ref_ns) {
+        timer->drift_ref_ns = now_ns;
+        timer->drift_ref_ticks = ticks;
+        return;
+    }
+    
+    uint64_t span_ticks = ticks - timer->drift_ref_ticks;
+    uint64_t span_ns = now_ns - timer->drift_ref_ns;
+    if (span_ticks < RTC_DRIFT_MIN_TICKS) {
+        return;
+    }
+    uint64_t window_ps = span_ns * 1000ULL / span_ticks;
+    
+    if (span_ns < (uint64_t)RTC_DRIFT_WINDOW_MS * 1000000ULL) {
+        if (windows == 0) {
+            atomic_store_explicit(&timer->tick_ps, window_ps, memory_order_relaxed);
+        }
+        return;
+    }
+    
+    int64_t estimate = (int64_t)atomic_load_explicit(&timer->tick_ps, memory_order_relaxed);
+    if (windows > 0) {
+        estimate += ((int64_t)window_ps - estimate) / RTC_DRIFT_SMOOTHING;
+    } else {
+        estimate = (int64_t)window_ps;
+    }
+    atomic_store_explicit(&timer->tick_ps, (uint64_t)estimate, memory_order_relaxed);
+    atomic_store_explicit(&timer->drift_windows, windows + 1, memory_order_relaxed);
+    timer->drift_ref_ns = now_ns;
+    timer->drift_ref_ticks = ticks;
+}
+
+/**
+ * @brief Program a tickless source for the next service deadline
+ *
+ * Runs on the monitor thread after every wakeup and control pass. The
+ * backend interrupts once when the deadline tick is reached and reports
+ * all ticks up to it, so the wheel catches up in a single wakeup.
+ */
+static void rtc_timer_rearm(rtc_tick_source_t* source) {
+    rtc_timer_wheel_t* wheel = &rtc_timers[source->timer_id].wheel;
+    rtc_device_t* dev = source->dev;
+    uint64_t now = rtc_wheel_now(wheel);
+    uint64_t next = rtc_wheel_next_expiry(wheel);
+    uint64_t ticks;
+    unsigned long base;
+    
+    if (!dev->tickless || source->fd < 0) {
+        return;
+    }
+    
+    ticks = (next > now) ? next - now : 1;
+    if (ticks > RTC_TICKLESS_MAX_TICKS) {
+        ticks = RTC_TICKLESS_MAX_TICKS;
+    }
+    if (source->armed_tick == now + ticks) {
+        return;  /* Already programmed */
+    }
+    
+    if (dev->backend->oneshot(dev, (uint32_t)ticks, &base) != 0) {
+        perror("Failed to program one-shot tick");
+        return;
+    }
+    /* Ticks are counted from the base; take it as the baseline before the first read */
+    if (!source->irq_count_valid) {
+        source->irq_count_valid = 1;
+        source->last_irq_count = base;
+    }
+    source->armed_tick = now + ticks;
+}
+
+/**
+ * @brief Wake the monitor thread to process control messages and service changes
+ */
+static void rtc_monitor_notify(void) {
+    int fd = atomic_load(&monitor_ctl_fd);
+    
+    if (fd >= 0) {
+        eventfd_write(fd, 1);
+    }
+}
+
+/**
+ * @brief Apply queued control messages (monitor thread only)
+ */
+static void rtc_monitor_handle_control(void) {
+    eventfd_t value;
+    
+    eventfd_read(atomic_load(&monitor_ctl_fd), &value);
+    
+    /* Arm newly registered services without waiting for their timer's next tick */
+    for (int i = 0; i < atomic_load(&rtc_timer_count); i++) {
+        rtc_timer_apply_changes(&rtc_timers[i]);
+    }
+    
+    pthread_mutex_lock(&ctl_mutex);
+    while (ctl_queue) {
+        rtc_ctl_msg_t *msg = ctl_queue;
+        ctl_queue = msg->next;
+        msg->result = -1;
+        
+        if (msg->type == RTC_CTL_ADD_SOURCE) {
+            for (uint32_t i = 0; i < RTC_MAX_TICK_SOURCES; i++) {
+                if (tick_sources[i].fd < 0) {
+                    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = i};
+                    if (epoll_ctl(monitor_epfd, EPOLL_CTL_ADD, msg->fd, &ev) == 0) {
+                        tick_sources[i].fd = msg->fd;
+                        tick_sources[i].timer_id = msg->timer_id;
+                        tick_sources[i].ext.fd = msg->fd;
+                        tick_sources[i].ext.backend = &rtc_tick_backend_nuclei;
+                        tick_sources[i].dev = &tick_sources[i].ext;
+                        tick_sources[i].irq_count_valid = 0;
+                        tick_sources[i].armed_tick = 0;
+                        msg->result = 0;
+                    }
+                    break;
+                }
+            }
+        } else if (msg->type == RTC_CTL_REMOVE_SOURCE) {
+            for (uint32_t i = 0; i < RTC_MAX_TICK_SOURCES; i++) {
+                if (tick_sources[i].fd >= 0 && tick_sources[i].fd == msg->fd) {
+                    epoll_ctl(monitor_epfd, EPOLL_CTL_DEL, msg->fd, NULL);
+                    tick_sources[i].fd = -1;
+                    msg->result = 0;
+                    break;
+                }
+            }
+        }
+        msg->done = 1;
+    }
+    pthread_cond_broadcast(&ctl_cond);
+    pthread_mutex_unlock(&ctl_mutex);
+}
+
+/**
+ * @brief Create the control condition variable on CLOCK_MONOTONIC
+ *
+ * Request deadlines must not move when the wall clock is set.
+ */
+static void rtc_ctl_cond_init(void) {
+    pthread_condattr_t attr;
+    
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&ctl_cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+/**
+ * @brief Send a control message to the monitor thread and wait until it is applied
+ *
+ * @return int Message result, -1 if the monitor did not answer in time
+ */
+static int rtc_monitor_request(rtc_ctl_msg_t *msg) {
+    struct timespec deadline;
+    
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += RTC_MONITOR_CTL_TIMEOUT_MS / 1000;
+    deadline.tv_nsec += (RTC_MONITOR_CTL_TIMEOUT_MS % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    pthread_mutex_lock(&ctl_mutex);
+    if (!atomic_load(&monitor_running)) {
+        pthread_mutex_unlock(&ctl_mutex);
+        return -1;
+    }
+    msg->done = 0;
+    msg->next = ctl_queue;
+    ctl_queue = msg;
+    rtc_monitor_notify();
+    
+    while (!msg->done) {
+        if (pthread_cond_timedwait(&ctl_cond, &ctl_mutex, &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+    
+    /* Withdraw a message the monitor never picked up */
+    if (!msg->done) {
+        for (rtc_ctl_msg_t **link = &ctl_queue; *link; link = &(*link)->next) {
+            if (*link == msg) {
+                *link = msg->next;
+                break;
+            }
+        }
+        msg->result = -1;
+        printf("RTC monitor did not answer control request within %d ms\n", RTC_MONITOR_CTL_TIMEOUT_MS);
+    }
+    pthread_mutex_unlock(&ctl_mutex);
+    
+    return msg->result;
+}
+
+/**
+ * @brief Reprogram every tickless source (monitor thread only)
+ */
+static void rtc_monitor_rearm_all(void) {
+    for (int i = 0; i < RTC_MAX_TICK_SOURCES; i++) {
+        if (tick_sources[i].fd >= 0) {
+            rtc_timer_rearm(&tick_sources[i]);
+        }
+    }
+}
+
+/**
+ * @brief IRQ monitoring thread
+ *
+ * Waits on an epoll set holding every tick source plus a control eventfd.
+ * Shutdown and reconfiguration are delivered through the eventfd, so the
+ * thread always leaves its wait promptly and is never cancelled.
+ */
+static void* rtc_irq_monitor_thread(void *arg) {
+    struct epoll_event events[RTC_MAX_TICK_SOURCES + 1];
+    int ret;
+    unsigned long irq_count;
+    uint64_t wakeup_ns;
+
+    printf("RTC interrupt monitoring thread started\n");
+    
+    /* Services registered before start are linked by the first control pass */
+    rtc_monitor_handle_control();
+    rtc_monitor_rearm_all();
+    
+    while (atomic_load(&monitor_running)) {
+        /* Wait for interrupt or control events */
+        ret = epoll_wait(monitor_epfd, events, RTC_MAX_TICK_SOURCES + 1, RTC_MONITOR_WAIT_MS);
+        
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;  /* Interrupted by signal, continue waiting */
+            }
+            perror("epoll_wait failed");
+            break;
+        }
+
+        if (!atomic_load(&monitor_running)) {
+            break;  /* Check exit flag */
+        }
+        
+        /* Wakeup time is only taken while something is traced */
+        wakeup_ns = atomic_load_explicit(&trace_services, memory_order_relaxed) ? rtc_monotonic_ns() : 0;
+        
+        for (int i = 0; i < ret; i++) {
+            uint32_t id = events[i].data.u32;
+            
+            if (id == RTC_CTL_EVENT_ID) {
+                rtc_monitor_handle_control();
+                continue;
+            }
+            if (id & RTC_CORO_EVENT_FLAG) {
+                rtc_monitor_coro_ready(id & ~RTC_CORO_EVENT_FLAG);
+                continue;
+            }
+            
+            /* Source may have been removed by a control message in this batch */
+            rtc_tick_source_t *source = &tick_sources[id];
+            if (source->fd < 0) {
+                continue;
+            }
+            
+            /* Interrupt occurred, read interrupt count */
+            if (source->dev->backend->read_count(source->dev, &irq_count) == 0) {
+                rtc_timer_t *timer = &rtc_timers[source->timer_id];
+                
+                /* Trace stamps for the services dispatched by this wakeup */
+                if (wakeup_ns && atomic_load_explicit(&timer->traced, memory_order_relaxed)) {
+                    timer->wakeup_ns = wakeup_ns;
+                    if (!source->dev->backend->irq_time ||
+                        source->dev->backend->irq_time(source->dev, &timer->irq_ns) != 0) {
+                        timer->irq_ns = 0;
+                    }
+                } else {
+                    timer->wakeup_ns = 0;
+                    timer->irq_ns = 0;
+                }
+                
+                /* Account elapsed ticks and dispatch to the source's timer */
+                rtc_timer_account_irq(source, irq_count);
+            }
+        }
+        
+        /* Deadlines may have moved after ticks or service changes */
+        rtc_monitor_rearm_all();
+    }
+
+    printf("RTC interrupt monitoring thread exited\n");
+    return NULL;
+}
+
+/**
+ * @brief Create the monitor's epoll set with the control eventfd and device sources
+ */
+static int rtc_monitor_open(void) {
+    pthread_once(&ctl_cond_once, rtc_ctl_cond_init);
+    
+    int ctl_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ctl_fd < 0) {
+        perror("Failed to create RTC control eventfd");
+        return -1;
+    }
+    
+    monitor_epfd = epoll_create1(EPOLL_CLOEXEC);
+    if (monitor_epfd < 0) {
+        perror("Failed to create RTC epoll set");
+        close(ctl_fd);
+        return -1;
+    }
+    
+    struct epoll_event ev = {.events = EPOLLIN, .data.u32 = RTC_CTL_EVENT_ID};
+    if (epoll_ctl(monitor_epfd, EPOLL_CTL_ADD, ctl_fd, &ev) != 0) {
+        perror("Failed to watch RTC control eventfd");
+        close(monitor_epfd);
+        monitor_epfd = -1;
+        close(ctl_fd);
+        return -1;
+    }
+    
+    /* Device i drives timer i */
+    for (uint32_t i = 0; i < RTC_MAX_TICK_SOURCES; i++) {
+        tick_sources[i].fd = -1;
+    }
+    for (uint32_t i = 0; i < (uint32_t)atomic_load(&rtc_timer_count); i++) {
+        ev.events = EPOLLIN;
+        ev.data.u32 = i;
+        if (epoll_ctl(monitor_epfd, EPOLL_CTL_ADD, rtc_devices[i].fd, &ev) != 0) {
+            perror("Failed to watch RTC device");
+            close(monitor_epfd);
+            monitor_epfd = -1;
+            close(ctl_fd);
+            return -1;
+        }
+        tick_sources[i].fd = rtc_devices[i].fd;
+        tick_sources[i].timer_id = (int)i;
+        tick_sources[i].dev = &rtc_devices[i];
+        tick_sources[i].irq_count_valid = 0;
+        tick_sources[i].armed_tick = 0;
+    }
+    
+    atomic_store(&monitor_ctl_fd, ctl_fd);
+    return 0;
+}
+
+/**
+ * @brief Release the monitor's epoll set and control eventfd
+ */
+static void rtc_monitor_close(void) {
+    int ctl_fd = atomic_exchange(&monitor_ctl_fd, -1);
+    
+    if (ctl_fd >= 0) {
+        close(ctl_fd);
+    }
+    if (monitor_epfd >= 0) {
+        close(monitor_epfd);
+        monitor_epfd = -1;
+    }
+}
+
+/**
+ * @brief Simulated duration of one tick of a timer in virtual time
+ */
+static uint64_t rtc_virtual_tick_ns(int timer_id) {
+    uint32_t period_us = rtc_devices[timer_id].period_us;
+    
+    return (uint64_t)(period_us ? period_us : RTC_VIRTUAL_TICK_US) * 1000ULL;
+}
+
+/**
+ * @brief Move the virtual clock and bring every timer's wheel up to it (virtual-time runner only)
+ *
+ * Plays the part of rtc_timer_account_irq() for the simulated ticks. Timers
+ * are taken in index order, so deadlines that fall on the same instant on
+ * several timers run lowest timer first.
+ */
+static void rtc_virtual_advance(int count, uint64_t now_ns) {
+    atomic_store_explicit(&virtual_now_ns, now_ns, memory_order_relaxed);
+    
+    for (int i = 0; i < count; i++) {
+        rtc_timer_t* timer = &rtc_timers[i];
+        uint64_t target = now_ns / rtc_virtual_tick_ns(i);
+        uint64_t tick = rtc_wheel_now(&timer->wheel);
+        
+        while (tick < target) {
+            uint32_t elapsed = (target - tick > UINT32_MAX) ? UINT32_MAX : (uint32_t)(target - tick);
+            
+            atomic_fetch_add_explicit(&timer->wakeups, 1, memory_order_relaxed);
+            uint64_t ticks = atomic_fetch_add_explicit(&timer->ticks, elapsed, memory_order_relaxed) + elapsed;
+            if (tick_shm) {
+                rtc_tick_shm_publish(tick_shm, i, ticks, now_ns,
+                                     atomic_load_explicit(&timer->tick_ps, memory_order_relaxed));
+            }
+            rtc_timer_tick_handler(i, elapsed, 0);
+            tick += elapsed;
+        }
+    }
+}
+
+/* ========================= Private Helper Functions ========================= */
+
+/**
+ * @brief Initialize timer wheels
+ *
+ * @note Services registered before rtc_init() stay on the pending-change
+ *       stack and are armed on the first tick.
+ */
+static int init_timer_services(void) {
+    for (int i = 0; i < RTC_TIMER_MAX; i++) {
+        rtc_wheel_init(&rtc_timers[i].wheel);
+        
+        /* The period is measured afresh for every device opened */
+        rtc_timers[i].drift_ref_ns = 0;
+        atomic_store(&rtc_timers[i].tick_ps, 0);
+        atomic_store(&rtc_timers[i].drift_windows, 0);
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Stop and forget all strands (rtc_mutex)
+ *
+ * @note Queued jobs still run, so this must happen before the slots go.
+ */
+static void cleanup_strands(void) {
+    for (int i = 0; i < RTC_STRAND_MAX; i++) {
+        service_executor_destroy(strands[i].executor);
+        memset(&strands[i], 0, sizeof(strands[i]));
+    }
+}
+
+/**
+ * @brief Cleanup timer services
+ *
+ * @note Called after the monitor thread and executor pool have been stopped,
+ *       so no other thread references a service slot.
+ */
+static void cleanup_timer_services(void) {
+    pthread_mutex_lock(&rtc_mutex);
+    
+    for (int i = 0; i < RTC_TIMER_MAX; i++) {
+        rtc_wheel_init(&rtc_timers[i].wheel);
+        rtc_timers[i].slack_list = NULL;
+        atomic_store(&rtc_timers[i].pending, NULL);
+        atomic_store(&rtc_timers[i].service_count, 0);
+        atomic_store(&rtc_timers[i].traced, 0);
+    }
+    atomic_store(&trace_services, 0);
+    rtc_trace_ring_reset(&trace_ring);
+    
+    pthread_mutex_lock(&registry_mutex);
+    memset(service_hash, 0, sizeof(service_hash));
+    pthread_mutex_unlock(&registry_mutex);
+    
+    cleanup_strands();
+    
+    for (int c = 0; c < RTC_SERVICE_CHUNKS; c++) {
+        timer_service_t* chunk = atomic_exchange(&service_chunks[c], NULL);
+        
+        if (!chunk) {
+            continue;
+        }
+        /* Dedicated executors of live or retiring services run any callbacks still queued before they go */
+        for (int i = 0; i < RTC_SERVICE_CHUNK_SIZE; i++) {
+            service_executor_destroy(chunk[i].executor);
+            free(chunk[i].pipeline);
+        }
+        free(chunk);
+    }
+    
+    pthread_mutex_unlock(&rtc_mutex);
+}
+
+/**
+ * @brief Claim a free service slot, growing the slot table if needed
+ *
+ * @return timer_service_t* Slot in SERVICE_CLAIMED phase, NULL if the table is full
+ */
+static timer_service_t* service_slot_claim(void) {
+    for (int c = 0; c < RTC_SERVICE_CHUNKS; c++) {
+        timer_service_t* chunk = atomic_load_explicit(&service_chunks[c], memory_order_acquire);
+        
+        if (!chunk) {
+            timer_service_t* fresh = calloc(RTC_SERVICE_CHUNK_SIZE, sizeof(timer_service_t));
+            if (!fresh) {
+                return NULL;
+            }
+            /* Another registration may have installed the chunk first */
+            if (atomic_compare_exchange_strong(&service_chunks[c], &chunk, fresh)) {
+                chunk = fresh;
+            } else {
+                free(fresh);
+            }
+        }
+        
+        for (int i = 0; i < RTC_SERVICE_CHUNK_SIZE; i++) {
+            unsigned int state = atomic_load(&chunk[i].state);
+            
+            if (SERVICE_PHASE(state) == SERVICE_FREE &&
+                atomic_compare_exchange_strong(&chunk[i].state, &state,
+                                               SERVICE_STATE(SERVICE_GEN(state), SERVICE_CLAIMED))) {
+                chunk[i].slot_index = (uint32_t)(c * RTC_SERVICE_CHUNK_SIZE + i);
+                return &chunk[i];
+            }
+        }
+    }
+    
+    return NULL;
+}
+
+/**
+ * @brief Get a slot by its position in the slot table, NULL if its chunk does not exist
+ */
+static timer_service_t* service_slot_at(uint32_t slot_index) {
+    timer_service_t* chunk;
+    
+    if (slot_index >= RTC_SERVICE_CHUNKS * RTC_SERVICE_CHUNK_SIZE) {
+        return NULL;
+    }
+    chunk = atomic_load_explicit(&service_chunks[slot_index / RTC_SERVICE_CHUNK_SIZE], memory_order_acquire);
+    return chunk ? &chunk[slot_index % RTC_SERVICE_CHUNK_SIZE] : NULL;
+}
+
+/**
+ * @brief Drop a slot reference; the last one recycles the slot with a new generation
+ */
+static void service_slot_release(timer_service_t* service, unsigned int ref) {
+    if (atomic_fetch_and_explicit(&service->refs, ~ref, memory_order_acq_rel) == ref) {
+        service_slot_free(service);
+    }
+}
+
+/**
+ * @brief Return an unreferenced slot to the free state
+ */
+static void service_slot_free(timer_service_t* service) {
+    /* The last reference may drop on the dedicated thread, which cannot join itself */
+    if (service->executor) {
+        service_post_change(&rtc_timers[service->timer_id], service);
+        return;
+    }
+    
+    unsigned int state = atomic_load(&service->state);
+    atomic_store(&service->state, SERVICE_STATE(SERVICE_GEN(state) + 1, SERVICE_FREE));
+}
+
+/**
+ * @brief Queue a service for the monitor thread to apply its registration change
+ */
+static void service_post_change(rtc_timer_t* timer, timer_service_t* service) {
+    if (atomic_exchange(&service->pending, 1)) {
+        return;  /* Already queued; the monitor reads the latest state */
+    }
+    
+    timer_service_t* head = atomic_load_explicit(&timer->pending, memory_order_relaxed);
+    do {
+        service->pending_next = head;
+    } while (!atomic_compare_exchange_weak_explicit(&timer->pending, &head, service,
+                                                    memory_order_release, memory_order_relaxed));
+    
+    rtc_monitor_notify();
+}
+
+/**
+ * @brief Find an active service by timer and name
+ *
+ * @param timer_id Timer index
+ * @param name Service name
+ * @param state Output: slot state observed when the service matched
+ * @return timer_service_t* Matching slot, NULL if not found
+ *
+ * @note The slot may be retired and reused as soon as the registry is
+ *       released, so the result only suits readers that filter by the
+ *       registration's generation (SERVICE_GEN(state)). Setters look the
+ *       service up and store into it while holding registry_mutex.
+ */
+static timer_service_t* service_find(int timer_id, const char *name, unsigned int *state) {
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (service) {
+        *state = atomic_load(&service->state);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    return service;
+}
+
+/**
+ * @brief Get the lookup bucket of a service name (FNV-1a over timer id and name)
+ */
+static timer_service_t** service_hash_bucket(int timer_id, const char *name) {
+    uint32_t hash = 2166136261U ^ (uint32_t)timer_id;
+    
+    hash *= 16777619U;
+    for (const unsigned char *p = (const unsigned char *)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619U;
+    }
+    return &service_hash[hash & (RTC_SERVICE_HASH_SIZE - 1)];
+}
+
+/**
+ * @brief Find an active service by name (registry_mutex held)
+ */
+static timer_service_t* service_hash_lookup(int timer_id, const char *name) {
+    for (timer_service_t *service = *service_hash_bucket(timer_id, name); service; service = service->hash_next) {
+        if (service->timer_id == timer_id && strcmp(service->service_name, name) == 0) {
+            return service;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Adapter running callbacks registered without context
+ */
+static void service_legacy_callback(void *ctx, const rtc_tick_info_t *info) {
+    timer_service_t *service = (timer_service_t *)ctx;
+    
+    (void)info;
+    service->callback_func();
+}
+
+/**
+ * @brief Adapter running self-rescheduling callbacks; hands the next run to the monitor
+ */
+static void service_resched_callback(void *ctx, const rtc_tick_info_t *info) {
+    timer_service_t *service = (timer_service_t *)ctx;
+    uint32_t delay = service->resched_func(service->resched_ctx, info);
+    
+    if (delay) {
+        atomic_store(&service->resched_due, info->sequence + delay);
+        service_post_change(&rtc_timers[service->timer_id], service);
+    }
+}
+
+/**
+ * @brief Step a coroutine service; runs under service_resched_callback()
+ *
+ * @return uint32_t Ticks to the next step, 0 to keep the period or await a descriptor
+ */
+static uint32_t service_coro_step(void *ctx, const rtc_tick_info_t *info) {
+    timer_service_t *service = (timer_service_t *)ctx;
+    rtc_coro_t *co = &service->coro;
+    
+    /* A firing that raced the wait being applied does not resume the coroutine */
+    if (co->wait == RTC_CORO_WAIT_TICKS && info->sequence < co->resume_tick) {
+        return (uint32_t)(co->resume_tick - info->sequence);
+    }
+    if (co->wait == RTC_CORO_WAIT_FD && !atomic_exchange(&service->coro_fd_ready, 0)) {
+        return 0;
+    }
+    
+    co->wait = service->coro_func(co, service->coro_ctx, info);
+    switch (co->wait) {
+        case RTC_CORO_WAIT_TICKS:
+            if (co->wait_ticks == 0) {
+                co->wait_ticks = 1;
+            }
+            co->resume_tick = info->sequence + co->wait_ticks;
+            return co->wait_ticks;
+            
+        case RTC_CORO_WAIT_FD:
+            atomic_store(&service->coro_wait_fd, co->wait_fd);
+            service_post_change(&rtc_timers[service->timer_id], service);
+            return 0;
+            
+        default:
+            co->wait = RTC_CORO_DONE;
+            co->line = 0;
+            return 0;
+    }
+}
+
+/**
+ * @brief Callback of pipeline services: run the due stages in order
+ */
+static void service_pipeline_run(void *ctx, const rtc_tick_info_t *info) {
+    rtc_pipeline_t *pipeline = (rtc_pipeline_t *)ctx;
+    
+    for (int i = 0; i < pipeline->stage_count; i++) {
+        rtc_pipeline_entry_t *stage = &pipeline->stages[i];
+        
+        if (pipeline->runs % stage->decimation == 0) {
+            stage->callback(stage->ctx, info);
+        }
+    }
+    pipeline->runs++;
+}
+
+/**
+ * @brief Pick a phase for a new service that does not collide with services sharing its interval
+ *
+ * Candidates follow the bit-reversed sequence 0, 1/2, 1/4, 3/4, ... of the
+ * period, so each new service lands in the middle of the largest gap.
+ */
+static int service_auto_phase(int timer_id, int interval) {
+    int taken[RTC_SERVICE_CHUNKS * RTC_SERVICE_CHUNK_SIZE];
+    int count = 0;
+    int phase = 0;
+    
+    /* Phases of active services with the same interval on this timer */
+    for (int c = 0; c < RTC_SERVICE_CHUNKS; c++) {
+        timer_service_t *chunk = atomic_load_explicit(&service_chunks[c], memory_order_acquire);
+        if (!chunk) {
+            break;
+        }
+        for (int i = 0; i < RTC_SERVICE_CHUNK_SIZE; i++) {
+            timer_service_t *service = &chunk[i];
+            
+            if (SERVICE_PHASE(atomic_load(&service->state)) == SERVICE_ACTIVE &&
+                service->timer_id == timer_id && atomic_load(&service->interval) == interval) {
+                taken[count++] = atomic_load(&service->phase);
+            }
+        }
+    }
+    
+    /* Try the first candidates of the sequence; fall back to phase 0 when all collide */
+    for (uint32_t k = 0; k < (uint32_t)interval && k < RTC_SERVICE_CHUNKS * RTC_SERVICE_CHUNK_SIZE; k++) {
+        uint32_t rev = k;
+        rev = ((rev >> 1) & 0x55555555U) | ((rev & 0x55555555U) << 1);
+        rev = ((rev >> 2) & 0x33333333U) | ((rev & 0x33333333U) << 2);
+        rev = ((rev >> 4) & 0x0F0F0F0FU) | ((rev & 0x0F0F0F0FU) << 4);
+        rev = ((rev >> 8) & 0x00FF00FFU) | ((rev & 0x00FF00FFU) << 8);
+        rev = (rev >> 16) | (rev << 16);
+        int candidate = (int)(((uint64_t)rev * (uint64_t)interval) >> 32);
+        int free_slot = 1;
+        
+        for (int j = 0; j < count; j++) {
+            if (taken[j] == candidate) {
+                free_slot = 0;
+                break;
+            }
+        }
+        if (free_slot) {
+            phase = candidate;
+            break;
+        }
+    }
+    
+    return phase;
+}
+
+/**
+ * @brief Length of a timer tick in nanoseconds: measured, else requested, else 0
+ */
+static uint64_t timer_tick_ns(int timer_id) {
+    uint64_t tick_ps = atomic_load_explicit(&rtc_timers[timer_id].tick_ps, memory_order_relaxed);
+    
+    return tick_ps ? tick_ps / 1000 : (uint64_t)rtc_devices[timer_id].period_us * 1000;
+}
+
+/**
+ * @brief Declared CPU share of a budget per period in permille, 0 if either is unknown
+ */
+static uint32_t budget_permille(uint64_t budget_ns, uint64_t period_ns) {
+    return (budget_ns && period_ns) ? (uint32_t)(budget_ns * 1000 / period_ns) : 0;
+}
+
+/**
+ * @brief CPU share of one service in permille, given a budget per run
+ *
+ * @return uint32_t Share used for admission: the higher of declared and measured
+ */
+static uint32_t service_share(timer_service_t *service, uint64_t budget_ns, uint64_t tick_ns, uint64_t now,
+                              uint32_t *declared, uint32_t *measured) {
+    uint64_t period_ns = tick_ns * (uint64_t)atomic_load(&service->interval);
+    uint64_t age = now - service->registered_ns;
+    
+    /* Declared: budget per period */
+    *declared = budget_permille(budget_ns, period_ns);
+    
+    /* Measured: runtime per second of age, once the service has settled */
+    *measured = 0;
+    if (age >= (uint64_t)RTC_BUDGET_SETTLE_MS * 1000000ULL) {
+        uint64_t total = atomic_load_explicit(&service->stats.runtime_total_ns, memory_order_relaxed);
+        *measured = (uint32_t)(total * 1000 / age);
+    }
+    return (*declared > *measured) ? *declared : *measured;
+}
+
+/**
+ * @brief Sum the CPU share of a timer's active services
+ *
+ * @param skip Service left out of the sums, NULL for none
+ */
+static void timer_utilization_sum(int timer_id, const timer_service_t *skip, rtc_timer_utilization_t *util) {
+    rtc_timer_t *timer = &rtc_timers[timer_id];
+    uint64_t tick_ns = timer_tick_ns(timer_id);
+    uint64_t now = rtc_monotonic_ns();
+    
+    memset(util, 0, sizeof(*util));
+    util->ceiling_permille = atomic_load(&timer->ceiling_permille);
+    util->policy = atomic_load(&timer->admission);
+    
+    for (int c = 0; c < RTC_SERVICE_CHUNKS; c++) {
+        timer_service_t *chunk = atomic_load_explicit(&service_chunks[c], memory_order_acquire);
+        if (!chunk) {
+            break;
+        }
+        for (int i = 0; i < RTC_SERVICE_CHUNK_SIZE; i++) {
+            timer_service_t *service = &chunk[i];
+            uint32_t declared, measured;
+            
+            if (service == skip || service->timer_id != timer_id ||
+                SERVICE_PHASE(atomic_load(&service->state)) != SERVICE_ACTIVE) {
+                continue;
+            }
+            util->admitted_permille += service_share(service, atomic_load_explicit(&service->budget_ns, memory_order_relaxed),
+                                                     tick_ns, now, &declared, &measured);
+            util->declared_permille += declared;
+            util->measured_permille += measured;
+            if (atomic_load_explicit(&service->stats.budget_overruns, memory_order_relaxed)) {
+                util->over_budget++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Check a service against a timer's utilization ceiling
+ *
+ * @param name Service being admitted
+ * @param skip Service whose current share extra_permille replaces, NULL for a new one
+ * @param extra_permille Share the service adds on top of the other services
+ * @return int 0 if admitted (possibly with a warning), -1 if rejected
+ */
+static int timer_admit(int timer_id, const char *name, const timer_service_t *skip, uint32_t extra_permille) {
+    rtc_timer_utilization_t util;
+    
+    timer_utilization_sum(timer_id, skip, &util);
+    if (util.policy == RTC_ADMISSION_OFF || util.ceiling_permille == 0 ||
+        util.admitted_permille + extra_permille <= util.ceiling_permille) {
+        return 0;
+    }
+    
+    printf("Service '%s' would take timer%d to %u/1000 CPU (ceiling %u/1000)%s\n",
+           name, timer_id, util.admitted_permille + extra_permille, util.ceiling_permille,
+           (util.policy == RTC_ADMISSION_ENFORCE) ? ", rejected" : "");
+    return (util.policy == RTC_ADMISSION_ENFORCE) ? -1 : 0;
+}
+
+/**
+ * @brief Copy a service's counters into a statistics snapshot
+ */
+static void service_stats_snapshot(timer_service_t* service, rtc_service_stats_t *stats) {
+    rtc_service_counters_t *c = &service->stats;
+    
+    memset(stats, 0, sizeof(*stats));
+    snprintf(stats->name, sizeof(stats->name), "%s", service->service_name);
+    rtc_strand_t *strand = atomic_load_explicit(&service->strand, memory_order_acquire);
+    if (strand) {
+        snprintf(stats->strand, sizeof(stats->strand), "%s", strand->name);
+    }
+    stats->interval = atomic_load(&service->interval);
+    stats->phase = atomic_load(&service->phase);
+    stats->dispatches = atomic_load_explicit(&c->dispatches, memory_order_relaxed);
+    stats->runs = atomic_load_explicit(&c->runs, memory_order_relaxed);
+    stats->overruns = atomic_load_explicit(&c->overruns, memory_order_relaxed);
+    stats->overrun_dropped = atomic_load_explicit(&c->overrun_dropped, memory_order_relaxed);
+    stats->late_dropped = atomic_load_explicit(&c->late_dropped, memory_order_relaxed);
+    stats->budget_ns = atomic_load_explicit(&service->budget_ns, memory_order_relaxed);
+    stats->budget_overruns = atomic_load_explicit(&c->budget_overruns, memory_order_relaxed);
+    stats->slack = atomic_load(&service->slack);
+    stats->slack_early = atomic_load_explicit(&c->slack_early, memory_order_relaxed);
+    stats->runtime_last_ns = atomic_load_explicit(&c->runtime_last_ns, memory_order_relaxed);
+    stats->runtime_min_ns = atomic_load_explicit(&c->runtime_min_ns, memory_order_relaxed);
+    stats->runtime_max_ns = atomic_load_explicit(&c->runtime_max_ns, memory_order_relaxed);
+    if (stats->runs) {
+        stats->runtime_mean_ns = atomic_load_explicit(&c->runtime_total_ns, memory_order_relaxed) / stats->runs;
+    } else {
+        stats->runtime_min_ns = 0;
+    }
+    for (int i = 0; i < RTC_LATENCY_HIST_BUCKETS; i++) {
+        stats->latency_hist[i] = atomic_load_explicit(&c->latency_hist[i], memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Start a single-thread executor dedicated to one service
+ *
+ * @return rtc_executor_t* Running executor, NULL on failure
+ */
+static rtc_executor_t* service_executor_create(const rtc_thread_attr_t *attr) {
+    rtc_executor_t *ex = malloc(sizeof(*ex));
+    
+    if (!ex) {
+        return NULL;
+    }
+    if (rtc_executor_start(ex, 1, attr) != 0) {
+        free(ex);
+        return NULL;
+    }
+    return ex;
+}
+
+/**
+ * @brief Stop and free a dedicated executor; no-op for NULL
+ */
+static void service_executor_destroy(rtc_executor_t *ex) {
+    if (ex) {
+        rtc_executor_stop(ex);
+        free(ex);
+    }
+}
+
+/**
+ * @brief Find a strand by name (rtc_mutex)
+ */
+static rtc_strand_t* strand_find(const char *name) {
+    for (int i = 0; i < RTC_STRAND_MAX; i++) {
+        if (strands[i].executor && strcmp(strands[i].name, name) == 0) {
+            return &strands[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Create a strand in a free entry (rtc_mutex)
+ *
+ * @return rtc_strand_t* New strand, NULL if the table is full or the thread failed
+ */
+static rtc_strand_t* strand_create(const char *name, const rtc_thread_attr_t *attr) {
+    for (int i = 0; i < RTC_STRAND_MAX; i++) {
+        if (strands[i].executor) {
+            continue;
+        }
+        strands[i].executor = service_executor_create(attr);
+        if (!strands[i].executor) {
+            printf("Failed to create thread for strand '%s'\n", name);
+            return NULL;
+        }
+        strncpy(strands[i].name, name, MAX_SERVICE_NAME_LEN - 1);
+        strands[i].name[MAX_SERVICE_NAME_LEN - 1] = '\0';
+        return &strands[i];
+    }
+    printf("Failed to create strand '%s': no free strands (max %d)\n", name, RTC_STRAND_MAX);
+    return NULL;
+}
+
+/**
+ * @brief Close all opened RTC devices
+ */
+static void close_rtc_devices(void) {
+    atomic_store(&rtc_timer_count, 0);
+    
+    for (int i = 0; i < RTC_TIMER_MAX; i++) {
+        if (rtc_devices[i].backend && rtc_devices[i].fd >= 0) {
+            rtc_devices[i].backend->close(&rtc_devices[i]);
+            rtc_devices[i].is_initialized = 0;
+            printf("RTC device %s closed\n", rtc_devices[i].device_path);
+        }
+    }
+}
+
+/**
+ * @brief Get a device entry, filling in the nuclei defaults on first use (rtc_mutex)
+ */
+static rtc_device_t* rtc_device_get(int timer_id) {
+    rtc_device_t *dev = &rtc_devices[timer_id];
+    
+    if (!dev->backend) {
+        dev->fd = -1;
+        dev->id = timer_id;
+        dev->backend = &rtc_tick_backend_nuclei;
+        snprintf(dev->device_path, sizeof(dev->device_path), NUCLEI_RTC_CHR_DEV_FMT, timer_id);
+    }
+    return dev;
+}
+
+/**
+ * @brief Check a timer index against the discovered timers (any slot before rtc_init())
+ */
+static int rtc_timer_valid(int timer_id) {
+    int count = atomic_load(&rtc_timer_count);
+    
+    return timer_id >= 0 && timer_id < (count ? count : RTC_TIMER_MAX);
+}
+
+/**
+ * @brief Count the timers to open (rtc_mutex)
+ *
+ * The kernel numbers nuclei devices in probe order, so timers are taken in
+ * order until one has neither a configured backend nor a device node.
+ */
+static int rtc_discover_devices(void) {
+    int count = 0;
+    
+    while (count < RTC_TIMER_MAX) {
+        rtc_device_t *dev = rtc_device_get(count);
+        
+        if (dev->backend == &rtc_tick_backend_nuclei && access(dev->device_path, F_OK) != 0) {
+            break;
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Register a service with a context callback, a plain callback_func,
+ *        a self-rescheduling callback, a coroutine or a pipeline
+ *
+ * @note A pipeline is owned by the slot once registration succeeds. A declared
+ *       budget is admitted against the timer's ceiling before the slot is published.
+ */
+static int service_register(int timer_id, const char *name, int interval, int phase,
+                            rtc_service_callback_t callback, void *ctx,
+                            void (*callback_func)(void), rtc_service_resched_t resched_func,
+                            rtc_coro_func_t coro_func, rtc_pipeline_t *pipeline,
+                            const rtc_thread_attr_t *attr, uint32_t budget_us) {
+    rtc_executor_t *executor = NULL;
+    
+    /* Parameter validation */
+    if (!name || (!callback && !callback_func && !resched_func && !coro_func && !pipeline) || interval <= 0 || !rtc_timer_valid(timer_id) ||
+        (phase != RTC_PHASE_AUTO && (phase < 0 || phase >= interval))) {
+        printf("Invalid parameters for service registration\n");
+        return -1;
+    }
+    
+    if (strlen(name) >= MAX_SERVICE_NAME_LEN) {
+        printf("Service name too long (max %d chars)\n", MAX_SERVICE_NAME_LEN - 1);
+        return -1;
+    }
+    
+    /* Create the dedicated callback thread first so a failure leaves no trace */
+    if (attr) {
+        executor = service_executor_create(attr);
+        if (!executor) {
+            printf("Failed to create callback thread for service '%s'\n", name);
+            return -1;
+        }
+    }
+    
+    /* Names are unique per timer; hold the registry until the service is published */
+    pthread_mutex_lock(&registry_mutex);
+    if (service_hash_lookup(timer_id, name)) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' already registered on timer%d\n", name, timer_id);
+        service_executor_destroy(executor);
+        return -1;
+    }
+    
+    /* Admit the declared cost before the service can run; the registry serializes admissions */
+    uint64_t tick_ns = timer_tick_ns(timer_id);
+    if (budget_us && !tick_ns) {
+        printf("Tick period of timer%d unknown, budget of '%s' not counted against the ceiling\n", timer_id, name);
+    }
+    if (timer_admit(timer_id, name, NULL,
+                    budget_permille((uint64_t)budget_us * 1000, tick_ns * (uint64_t)interval)) != 0) {
+        pthread_mutex_unlock(&registry_mutex);
+        service_executor_destroy(executor);
+        return -1;
+    }
+    
+    timer_service_t *service = service_slot_claim();
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Failed to register service '%s' on timer%d: no available slots\n", name, timer_id);
+        service_executor_destroy(executor);
+        return -1;
+    }
+    
+    /* Initialize service state; nothing else touches a claimed slot */
+    free(service->pipeline);
+    service->timer_id = timer_id;
+    service->threshold = interval;
+    atomic_store(&service->interval, interval);
+    atomic_store(&service->phase, (phase == RTC_PHASE_AUTO) ? service_auto_phase(timer_id, interval) : phase);
+    if (pipeline) {
+        service->callback = service_pipeline_run;
+        service->ctx = pipeline;
+    } else if (resched_func || coro_func) {
+        service->callback = service_resched_callback;
+        service->ctx = service;
+    } else {
+        service->callback = callback_func ? service_legacy_callback : callback;
+        service->ctx = callback_func ? (void *)service : ctx;
+    }
+    service->callback_func = callback_func;
+    service->resched_func = coro_func ? service_coro_step : resched_func;
+    service->resched_ctx = coro_func ? (void *)service : ctx;
+    service->coro_func = coro_func;
+    service->coro_ctx = ctx;
+    memset(&service->coro, 0, sizeof(service->coro));
+    atomic_store(&service->coro_wait_fd, -1);
+    atomic_store(&service->coro_fd_ready, 0);
+    service->coro_watch_fd = -1;
+    atomic_store(&service->resched_due, 0);
+    service->pipeline = pipeline;
+    service->executor = executor;
+    atomic_store(&service->strand, NULL);
+    atomic_store(&service->slack, 0);
+    service->slack_ticks = 0;
+    service->slack_next = NULL;
+    atomic_store(&service->budget_ns, (uint64_t)budget_us * 1000);
+    atomic_store(&service->budget_warned, 0);
+    service->registered_ns = rtc_monotonic_ns();
+    atomic_store(&service->catchup_policy, RTC_CATCHUP_COALESCE);
+    atomic_store(&service->catchup_max, 0);
+    atomic_store(&service->overrun_policy, RTC_OVERRUN_RETRY);
+    atomic_store(&service->overrun_alarm, NULL);
+    atomic_store(&service->overrun_ctx, NULL);
+    atomic_store(&service->overrun_events, 0);
+    atomic_store(&service->overrun_lost, 0);
+    atomic_store(&service->trace, 0);
+    service->trace_dispatch_ns = 0;
+    memset(&service->stats, 0, sizeof(service->stats));
+    atomic_store(&service->stats.runtime_min_ns, UINT64_MAX);
+    strncpy(service->service_name, name, MAX_SERVICE_NAME_LEN - 1);
+    service->service_name[MAX_SERVICE_NAME_LEN - 1] = '\0';
+    atomic_store(&service->refs, SERVICE_REF_WHEEL);
+    
+    /* Publish, then hand over to the monitor thread to arm on the wheel */
+    rtc_timer_t *timer = &rtc_timers[timer_id];
+    unsigned int state = atomic_load(&service->state);
+    atomic_fetch_add(&timer->service_count, 1);
+    atomic_store(&service->state, SERVICE_STATE(SERVICE_GEN(state), SERVICE_ACTIVE));
+    timer_service_t **bucket = service_hash_bucket(timer_id, name);
+    service->hash_next = *bucket;
+    *bucket = service;
+    pthread_mutex_unlock(&registry_mutex);
+    service_post_change(timer, service);
+    
+    printf("Service '%s' registered successfully on timer%d (interval=%d, phase=%d%s)\n", 
+           name, timer_id, interval, atomic_load(&service->phase), executor ? ", dedicated thread" : "");
+    return 0;
+}
+
+/* ========================= Public API Functions ========================= */
+
+/**
+ * @brief Initialize RTC devices and monitoring thread
+ */
+int rtc_init(void) {
+    pthread_mutex_lock(&rtc_mutex);
+    
+    /* Check if already initialized */
+    if (atomic_load(&rtc_timer_count) > 0) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("RTC devices already initialized\n");
+        return 0;
+    }
+    
+    int count = virtual_timers ? virtual_timers : rtc_discover_devices();
+    if (count == 0) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("No RTC devices found\n");
+        return -1;
+    }
+    
+    /* Simulated timers must not tick on their own */
+    for (int i = 0; i < count && virtual_timers; i++) {
+        if (rtc_devices[i].backend != &rtc_tick_backend_emu) {
+            pthread_mutex_unlock(&rtc_mutex);
+            printf("Timer%d: virtual time needs the emu tick backend\n", i);
+            return -1;
+        }
+    }
+    
+    /* Open and start RTC devices through their tick backends */
+    for (int i = 0; i < count; i++) {
+        rtc_device_t *dev = &rtc_devices[i];
+        
+        if (dev->backend->open(dev) != 0) {
+            /* Close already opened devices */
+            close_rtc_devices();
+            pthread_mutex_unlock(&rtc_mutex);
+            return -1;
+        }
+        dev->is_initialized = 1;
+        if (dev->backend->arm(dev, dev->period_us) != 0) {
+            close_rtc_devices();
+            pthread_mutex_unlock(&rtc_mutex);
+            return -1;
+        }
+        printf("RTC device %s opened successfully (fd=%d, backend=%s)\n", 
+               dev->device_path, dev->fd, dev->backend->name);
+    }
+    atomic_store(&rtc_timer_count, count);
+
+    /* Initialize timer services */
+    if (init_timer_services() != 0) {
+        perror("Failed to initialize timer services");
+        close_rtc_devices();
+        pthread_mutex_unlock(&rtc_mutex);
+        return -1;
+    }
+    
+    /* Create the monitor's epoll set and control eventfd */
+    if (rtc_monitor_open() != 0) {
+        close_rtc_devices();
+        pthread_mutex_unlock(&rtc_mutex);
+        return -1;
+    }
+    
+    /* Create the tick page before the monitor can publish into it */
+    if (tick_shm_name[0] != '\0') {
+        tick_shm = rtc_tick_shm_create(tick_shm_name, count);
+        if (!tick_shm) {
+            rtc_monitor_close();
+            close_rtc_devices();
+            pthread_mutex_unlock(&rtc_mutex);
+            return -1;
+        }
+    }
+    
+    /* In virtual time the caller of rtc_virtual_run() does the work of the pool and monitor */
+    if (virtual_timers) {
+        for (int i = 0; i < count; i++) {
+            atomic_store(&rtc_timers[i].tick_ps, rtc_virtual_tick_ns(i) * 1000ULL);
+        }
+        atomic_store(&virtual_now_ns, 0);
+        atomic_store(&virtual_time, 1);
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("RTC initialization completed in virtual time (%d timers)\n", count);
+        return 0;
+    }
+    
+    /* Start callback executor pool */
+    if (rtc_executor_start(&worker_pool, worker_pool_size, NULL) != 0) {
+        printf("Failed to start RTC executor pool\n");
+        rtc_tick_shm_destroy(tick_shm, tick_shm_name);
+        tick_shm = NULL;
+        rtc_monitor_close();
+        close_rtc_devices();
+        pthread_mutex_unlock(&rtc_mutex);
+        return -1;
+    }
+    worker_pool_running = 1;
+    
+    /* Create interrupt monitoring thread */
+    pthread_attr_t pattr;
+    pthread_attr_init(&pattr);
+    rtc_thread_attr_fill(&pattr, &monitor_attr);  /* Validated by rtc_set_monitor_attr() */
+    atomic_store(&monitor_running, 1);
+    int ret = pthread_create(&monitor_thread, &pattr, rtc_irq_monitor_thread, NULL);
+    pthread_attr_destroy(&pattr);
+    if (ret != 0) {
+        printf("Failed to create RTC interrupt monitor thread: %s\n", strerror(ret));
+        /* Cleanup resources */
+        atomic_store(&monitor_running, 0);
+        rtc_executor_stop(&worker_pool);
+        worker_pool_running = 0;
+        rtc_tick_shm_destroy(tick_shm, tick_shm_name);
+        tick_shm = NULL;
+        rtc_monitor_close();
+        close_rtc_devices();
+        pthread_mutex_unlock(&rtc_mutex);
+        return -1;
+    }
+    
+    pthread_mutex_unlock(&rtc_mutex);
+    printf("RTC initialization completed successfully (%d timers, %d executor threads)\n", count, worker_pool_size);
+    return 0;
+}
+
+/**
+ * @brief Enable RTC interrupt via standard RTC ioctl
+ */
+int rtc_enable_irq(int rtc_num) {
+    char device_path[64];
+    
+    if (!rtc_timer_valid(rtc_num)) {
+        printf("Invalid RTC number: %d\n", rtc_num);
+        return -1;
+    }
+    
+    snprintf(device_path, sizeof(device_path), RTC_DEV_FMT, rtc_num);
+    int fd = open(device_path, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open RTC device");
+        return -1;
+    }
+    
+    /* Enable interrupt using standard RTC interface */
+    int ret = ioctl(fd, RTC_VL_READ, 0);
+    close(fd);
+    
+    if (ret < 0) {
+        perror("Failed to enable RTC interrupt");
+        return -1;
+    }
+    
+    printf("RTC%d interrupt enabled successfully\n", rtc_num);
+    return 0;
+}
+
+/**
+ * @brief Disable RTC interrupt via standard RTC ioctl
+ */
+int rtc_disable_irq(int rtc_num) {
+    char device_path[64];
+    
+    if (!rtc_timer_valid(rtc_num)) {
+        printf("Invalid RTC number: %d\n", rtc_num);
+        return -1;
+    }
+    
+    snprintf(device_path, sizeof(device_path), RTC_DEV_FMT, rtc_num);
+    int fd = open(device_path, O_RDONLY);
+    if (fd < 0) {
+        perror("Failed to open RTC device");
+        return -1;
+    }
+    
+    /* Disable interrupt using standard RTC interface */
+    int ret = ioctl(fd, RTC_VL_CLR, 0);
+    close(fd);
+    
+    if (ret < 0) {
+        perror("Failed to disable RTC interrupt");
+        return -1;
+    }
+    
+    printf("RTC%d interrupt disabled successfully\n", rtc_num);
+    return 0;
+}
+
+/**
+ * @brief Register a timer service
+ */
+int rtc_register_service(int timer_id, const char *name, int interval, void (*callback_func)(void)) {
+    return service_register(timer_id, name, interval, RTC_PHASE_AUTO, NULL, NULL, callback_func, NULL, NULL, NULL, NULL, 0);
+}
+
+/**
+ * @brief Register a timer service whose callback takes a context and tick information
+ */
+int rtc_register_service_ctx(int timer_id, const char *name, int interval,
+                             rtc_service_callback_t callback, void *ctx) {
+    return service_register(timer_id, name, interval, RTC_PHASE_AUTO, callback, ctx, NULL, NULL, NULL, NULL, NULL, 0);
+}
+
+/**
+ * @brief Register a timer service with a phase, its own scheduling attributes and a CPU budget
+ */
+int rtc_register_service_ex(int timer_id, const char *name, int interval, int phase,
+                            rtc_service_callback_t callback, void *ctx, const rtc_thread_attr_t *attr,
+                            uint32_t budget_us) {
+    return service_register(timer_id, name, interval, phase, callback, ctx, NULL, NULL, NULL, NULL, attr, budget_us);
+}
+
+/**
+ * @brief Register a service whose callback chooses the delay to its next run
+ */
+int rtc_register_service_resched(int timer_id, const char *name, int interval, int phase,
+                                 rtc_service_resched_t callback, void *ctx,
+                                 const rtc_thread_attr_t *attr) {
+    return service_register(timer_id, name, interval, phase, NULL, ctx, NULL, callback, NULL, NULL, attr, 0);
+}
+
+/**
+ * @brief Register a stackless coroutine service
+ */
+int rtc_register_coroutine(int timer_id, const char *name, int interval, int phase,
+                           rtc_coro_func_t func, void *ctx, const rtc_thread_attr_t *attr) {
+    if (!func) {
+        printf("Invalid coroutine for service registration\n");
+        return -1;
+    }
+    return service_register(timer_id, name, interval, phase, NULL, ctx, NULL, NULL, func, NULL, attr, 0);
+}
+
+/**
+ * @brief Register a service that runs a pipeline of stages in order on every firing
+ */
+int rtc_register_pipeline(int timer_id, const char *name, int interval, int phase,
+                          const rtc_pipeline_stage_t *stages, int stage_count,
+                          const rtc_thread_attr_t *attr) {
+    if (!stages || stage_count <= 0 || stage_count > RTC_PIPELINE_MAX_STAGES) {
+        printf("Invalid pipeline stage count: %d\n", stage_count);
+        return -1;
+    }
+    
+    rtc_pipeline_t *pipeline = calloc(1, sizeof(*pipeline));
+    if (!pipeline) {
+        return -1;
+    }
+    for (int i = 0; i < stage_count; i++) {
+        rtc_pipeline_entry_t *entry = &pipeline->stages[i];
+        
+        if (!stages[i].callback || stages[i].decimation < 0) {
+            printf("Invalid stage %d of pipeline '%s'\n", i, name ? name : "");
+            free(pipeline);
+            return -1;
+        }
+        if (stages[i].name) {
+            strncpy(entry->name, stages[i].name, MAX_SERVICE_NAME_LEN - 1);
+        }
+        entry->callback = stages[i].callback;
+        entry->ctx = stages[i].ctx;
+        entry->decimation = stages[i].decimation ? (uint32_t)stages[i].decimation : 1;
+    }
+    pipeline->stage_count = stage_count;
+    
+    if (service_register(timer_id, name, interval, phase, NULL, NULL, NULL, NULL, NULL, pipeline, attr, 0) != 0) {
+        free(pipeline);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Unregister a timer service
+ */
+int rtc_unregister_service(int timer_id, const char *name) {
+    /* Parameter validation */
+    if (!name || !rtc_timer_valid(timer_id)) {
+        printf("Invalid service name or timer_id\n");
+        return -1;
+    }
+    
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t **link = service_hash_bucket(timer_id, name);
+    while (*link && ((*link)->timer_id != timer_id || strcmp((*link)->service_name, name) != 0)) {
+        link = &(*link)->hash_next;
+    }
+    
+    timer_service_t *service = *link;
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    
+    /* Only the registry retires services, so the slot is still active here */
+    *link = service->hash_next;
+    service->hash_next = NULL;
+    unsigned int state = atomic_load(&service->state);
+    atomic_store(&service->state, SERVICE_STATE(SERVICE_GEN(state), SERVICE_RETIRING));
+    atomic_fetch_sub(&rtc_timers[timer_id].service_count, 1);
+    if (atomic_exchange(&service->trace, 0)) {
+        atomic_fetch_sub(&rtc_timers[timer_id].traced, 1);
+        atomic_fetch_sub(&trace_services, 1);
+    }
+    pthread_mutex_unlock(&registry_mutex);
+    service_post_change(&rtc_timers[timer_id], service);
+    
+    printf("Service '%s' unregistered successfully from timer%d\n", 
+           name, timer_id);
+    return 0;
+}
+
+/**
+ * @brief Get the number of registered services on the specified timer
+ */
+int rtc_get_service_count(int timer_id) {
+    if (!rtc_timer_valid(timer_id)) {
+        return -1;
+    }
+    
+    return atomic_load(&rtc_timers[timer_id].service_count);
+}
+
+/**
+ * @brief Set how a service catches up on missed firings
+ */
+int rtc_set_service_catchup(int timer_id, const char *name, rtc_catchup_policy_t policy, int max_runs) {
+    if (!name || !rtc_timer_valid(timer_id) ||
+        policy < RTC_CATCHUP_COALESCE || policy > RTC_CATCHUP_REPLAY || max_runs < 0) {
+        printf("Invalid parameters for service catch-up policy\n");
+        return -1;
+    }
+    
+    /* Stored under the registry so the slot cannot be retired and reused meanwhile */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    
+    atomic_store(&service->catchup_max, (unsigned int)max_runs);
+    atomic_store(&service->catchup_policy, policy);
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
+}
+
+/**
+ * @brief Set how a service handles firings that come due while its callback is still running
+ */
+int rtc_set_service_overrun(int timer_id, const char *name, rtc_overrun_policy_t policy,
+                            rtc_overrun_alarm_t alarm, void *alarm_ctx) {
+    if (!name || !rtc_timer_valid(timer_id) ||
+        policy < RTC_OVERRUN_RETRY || policy > RTC_OVERRUN_COALESCE) {
+        printf("Invalid parameters for service overrun policy\n");
+        return -1;
+    }
+    
+    /* Stored under the registry so the slot cannot be retired and reused meanwhile */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    
+    atomic_store(&service->overrun_ctx, alarm_ctx);
+    atomic_store(&service->overrun_alarm, alarm);
+    atomic_store(&service->overrun_policy, policy);
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
+}
+
+/**
+ * @brief Create a named strand with its own scheduling attributes
+ */
+int rtc_create_strand(const char *strand, const rtc_thread_attr_t *attr) {
+    if (!strand || *strand == '\0' || strlen(strand) >= MAX_SERVICE_NAME_LEN) {
+        printf("Invalid strand name\n");
+        return -1;
+    }
+    
+    pthread_mutex_lock(&rtc_mutex);
+    if (strand_find(strand)) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("Strand '%s' already exists\n", strand);
+        return -1;
+    }
+    int ret = strand_create(strand, attr) ? 0 : -1;
+    pthread_mutex_unlock(&rtc_mutex);
+    return ret;
+}
+
+/**
+ * @brief Move a service to a named strand or back to the shared pool
+ */
+int rtc_set_service_strand(int timer_id, const char *name, const char *strand) {
+    if (!name || !rtc_timer_valid(timer_id) ||
+        (strand && (*strand == '\0' || strlen(strand) >= MAX_SERVICE_NAME_LEN))) {
+        printf("Invalid parameters for service strand\n");
+        return -1;
+    }
+    
+    /* rtc_mutex before the registry, as in cleanup; the slot cannot be reused until both are dropped */
+    pthread_mutex_lock(&rtc_mutex);
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service || service->executor) {
+        pthread_mutex_unlock(&registry_mutex);
+        pthread_mutex_unlock(&rtc_mutex);
+        if (!service) {
+            printf("Service '%s' not found on timer%d\n", name, timer_id);
+        } else {
+            printf("Service '%s' runs on its own thread and cannot join a strand\n", name);
+        }
+        return -1;
+    }
+    
+    /* The monitor picks the new executor up at the service's next dispatch */
+    rtc_strand_t *target = NULL;
+    if (strand) {
+        target = strand_find(strand);
+        if (!target) {
+            target = strand_create(strand, NULL);
+        }
+        if (!target) {
+            pthread_mutex_unlock(&registry_mutex);
+            pthread_mutex_unlock(&rtc_mutex);
+            return -1;
+        }
+    }
+    atomic_store_explicit(&service->strand, target, memory_order_release);
+    pthread_mutex_unlock(&registry_mutex);
+    pthread_mutex_unlock(&rtc_mutex);
+    return 0;
+}
+
+/**
+ * @brief Set the CPU utilization ceiling of a timer's services
+ */
+int rtc_set_timer_ceiling(int timer_id, int ceiling_permille, rtc_admission_policy_t policy) {
+    if (!rtc_timer_valid(timer_id) || ceiling_permille < 0 ||
+        policy < RTC_ADMISSION_OFF || policy > RTC_ADMISSION_ENFORCE) {
+        printf("Invalid parameters for timer utilization ceiling\n");
+        return -1;
+    }
+    
+    atomic_store(&rtc_timers[timer_id].ceiling_permille, (unsigned int)ceiling_permille);
+    atomic_store(&rtc_timers[timer_id].admission, policy);
+    return 0;
+}
+
+/**
+ * @brief Declare the CPU cost of one run of a service
+ */
+int rtc_set_service_budget(int timer_id, const char *name, uint32_t budget_us) {
+    if (!name || !rtc_timer_valid(timer_id)) {
+        printf("Invalid parameters for service budget\n");
+        return -1;
+    }
+    
+    /* Stored under the registry so the slot cannot be retired and reused meanwhile */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    if (!atomic_load(&service->budget_ns)) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' on timer%d has no budget; declare it at registration\n", name, timer_id);
+        return -1;
+    }
+    
+    /* Admit the new figure in place of the service's current share; a rejection keeps the old one */
+    uint64_t tick_ns = timer_tick_ns(timer_id);
+    uint32_t declared, measured;
+    uint32_t share = service_share(service, (uint64_t)budget_us * 1000, tick_ns, rtc_monotonic_ns(),
+                                   &declared, &measured);
+    if (budget_us && !tick_ns) {
+        printf("Tick period of timer%d unknown, budget of '%s' not counted against the ceiling\n", timer_id, name);
+    }
+    if (timer_admit(timer_id, name, service, share) != 0) {
+        pthread_mutex_unlock(&registry_mutex);
+        return -1;
+    }
+    
+    atomic_store(&service->budget_warned, 0);
+    atomic_store(&service->budget_ns, (uint64_t)budget_us * 1000);
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
+}
+
+/**
+ * @brief Get the CPU utilization of a timer's services
+ */
+int rtc_get_timer_utilization(int timer_id, rtc_timer_utilization_t *util) {
+    if (!util || !rtc_timer_valid(timer_id)) {
+        return -1;
+    }
+    
+    timer_utilization_sum(timer_id, NULL, util);
+    return 0;
+}
+
+/**
+ * @brief Change the trigger interval of a running service
+ */
+int rtc_set_service_interval(int timer_id, const char *name, int interval) {
+    if (!name || interval <= 0 || !rtc_timer_valid(timer_id)) {
+        printf("Invalid parameters for service interval\n");
+        return -1;
+    }
+    
+    /* Stored under the registry so the slot cannot be retired and reused meanwhile */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    
+    /* The monitor re-times the wheel entry when it applies the change */
+    atomic_store(&service->interval, interval);
+    service_post_change(&rtc_timers[timer_id], service);
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
+}
+
+/**
+ * @brief Let a service's firings be delayed so they share wakeups with other services
+ */
+int rtc_set_service_slack(int timer_id, const char *name, int slack) {
+    if (!name || slack < 0 || !rtc_timer_valid(timer_id)) {
+        printf("Invalid parameters for service slack\n");
+        return -1;
+    }
+    
+    /* Stored under the registry so the slot cannot be retired and reused meanwhile */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    if (slack >= atomic_load(&service->interval)) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Slack of service '%s' must be below its interval\n", name);
+        return -1;
+    }
+    
+    /* The monitor moves the wheel entry to the end of the window when it applies the change */
+    atomic_store(&service->slack, slack);
+    service_post_change(&rtc_timers[timer_id], service);
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
+}
+
+/**
+ * @brief Get execution statistics of a service
+ */
+int rtc_get_service_stats(int timer_id, const char *name, rtc_service_stats_t *stats) {
+    if (!name || !stats || !rtc_timer_valid(timer_id)) {
+        return -1;
     }
-
-    /* Clear running flag */
+    
+    /* Under the registry so the snapshot cannot mix in a reused slot's registration */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
     if (service) {
-        pthread_mutex_lock(&service->service_mutex);
-        service->is_running = 0;
-        pthread_mutex_unlock(&service->service_mutex);
+        service_stats_snapshot(service, stats);
     }
-    
-    /* Detach thread to let system reclaim resources automatically */
-    pthread_detach(pthread_self());
-    return NULL;
+    pthread_mutex_unlock(&registry_mutex);
+    return service ? 0 : -1;
 }
 
 /**
- * @brief Timer0 tick handler function
+ * @brief Get execution statistics of all services on a timer
  */
-static void rtc_timer_tick_handler(void) {
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        timer_service_t* service = &services_timer0[i];
-        
-        if (!service->callback_func) {
-            continue;
+int rtc_get_all_service_stats(int timer_id, rtc_service_stats_t *stats, int max_count) {
+    int count = 0;
+    
+    if (!stats || max_count < 0 || !rtc_timer_valid(timer_id)) {
+        return -1;
+    }
+    
+    /* Under the registry so no slot is retired and reused while it is copied */
+    pthread_mutex_lock(&registry_mutex);
+    for (int c = 0; c < RTC_SERVICE_CHUNKS && count < max_count; c++) {
+        timer_service_t *chunk = atomic_load_explicit(&service_chunks[c], memory_order_acquire);
+        if (!chunk) {
+            break;
         }
         
-        pthread_mutex_lock(&service->service_mutex);
-        service->count++;
-        
-        if (service->count >= service->threshold) {
-            if (!service->is_running && service->callback_func) {
-                service->is_running = 1;  /* Mark as running to prevent re-entrancy */
-                service->count = 0;       /* Reset counter */
-                pthread_mutex_unlock(&service->service_mutex);
-
-                /* Create thread to execute callback */
-                pthread_t task_thread;
-                int ret = pthread_create(&task_thread, NULL, task_thread_func, service);
-                if (ret != 0) {
-                    printf("Failed to create task thread for service %s: %s\n", 
-                           service->service_name, strerror(ret));
-                    /* Restore running flag if thread creation fails */
-                    pthread_mutex_lock(&service->service_mutex);
-                    service->is_running = 0;
-                    pthread_mutex_unlock(&service->service_mutex);
-                }
-            } else {
-                /* Already running or callback unregistered */
-                pthread_mutex_unlock(&service->service_mutex);
+        for (int i = 0; i < RTC_SERVICE_CHUNK_SIZE && count < max_count; i++) {
+            if (SERVICE_PHASE(atomic_load(&chunk[i].state)) == SERVICE_ACTIVE &&
+                chunk[i].timer_id == timer_id) {
+                service_stats_snapshot(&chunk[i], &stats[count++]);
             }
-        } else {
-            pthread_mutex_unlock(&service->service_mutex);
         }
     }
+    pthread_mutex_unlock(&registry_mutex);
+    
+    return count;
 }
 
 /**
- * @brief Timer1 tick handler function
+ * @brief Enable or disable latency tracing of a service
  */
-static void rtc_timer_tick_handler2(void) {
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        timer_service_t* service = &services_timer1[i];
-        
-        if (!service->callback_func) {
-            continue;
-        }
-        
-        pthread_mutex_lock(&service->service_mutex);
-        service->count++;
-        
-        if (service->count >= service->threshold) {
-            if (!service->is_running && service->callback_func) {
-                service->is_running = 1;  /* Mark as running to prevent re-entrancy */
-                service->count = 0;       /* Reset counter */
-                pthread_mutex_unlock(&service->service_mutex);
-
-                /* Create thread to execute callback */
-                pthread_t task_thread;
-                int ret = pthread_create(&task_thread, NULL, task_thread_func, service);
-                if (ret != 0) {
-                    printf("Failed to create task thread for service %s: %s\n", 
-                           service->service_name, strerror(ret));
-                    /* Restore running flag if thread creation fails */
-                    pthread_mutex_lock(&service->service_mutex);
-                    service->is_running = 0;
-                    pthread_mutex_unlock(&service->service_mutex);
-                }
-            } else {
-                /* Already running or callback unregistered */
-                pthread_mutex_unlock(&service->service_mutex);
-            }
-        } else {
-            pthread_mutex_unlock(&service->service_mutex);
-        }
+int rtc_set_service_trace(int timer_id, const char *name, int enable) {
+    if (!name || !rtc_timer_valid(timer_id)) {
+        printf("Invalid parameters for service tracing\n");
+        return -1;
+    }
+    
+    /* Under the registry so the traced counts stay in step with unregistration */
+    pthread_mutex_lock(&registry_mutex);
+    timer_service_t *service = service_hash_lookup(timer_id, name);
+    if (!service) {
+        pthread_mutex_unlock(&registry_mutex);
+        printf("Service '%s' not found on timer%d\n", name, timer_id);
+        return -1;
+    }
+    
+    enable = enable ? 1 : 0;
+    if (atomic_exchange(&service->trace, enable) != enable) {
+        atomic_fetch_add(&rtc_timers[timer_id].traced, enable ? 1 : -1);
+        atomic_fetch_add(&trace_services, enable ? 1 : -1);
     }
+    pthread_mutex_unlock(&registry_mutex);
+    return 0;
 }
 
 /**
- * @brief IRQ monitoring thread
+ * @brief Mark the point at which the running callback made its output visible
  */
-static void* rtc_irq_monitor_thread(void *arg) {
-    struct pollfd pfd[2];
-    int ret;
-    unsigned long irq_count;
-
-    printf("RTC interrupt monitoring thread started\n");
+void rtc_trace_mark(void) {
+    if (trace_current && !trace_current->stamp[RTC_TRACE_PUBLISH]) {
+        trace_current->stamp[RTC_TRACE_PUBLISH] = rtc_clock_ns();
+    }
+}
 
-    /* Setup pollfd array */
-    pfd[0].fd = rtc_devices[0].fd;
-    pfd[0].events = POLLIN;
+/**
+ * @brief Get per-stage latency percentiles of a traced service
+ */
+int rtc_get_service_trace(int timer_id, const char *name, rtc_trace_report_t *report) {
+    if (!name || !report || !rtc_timer_valid(timer_id)) {
+        return -1;
+    }
     
-    pfd[1].fd = rtc_devices[1].fd;
-    pfd[1].events = POLLIN;
+    unsigned int state;
+    timer_service_t *service = service_find(timer_id, name, &state);
+    if (!service) {
+        return -1;
+    }
     
-    while (monitor_running) {
-        /* Wait for interrupt events */
-        ret = poll(pfd, 2, -1);   /* Monitor 2 fds, -1 means wait forever */
-        
-        if (ret < 0) {
-            if (errno == EINTR) {
-                continue;  /* Interrupted by signal, continue waiting */
-            }
-            perror("poll failed");
-            break;
-        }
-
-        if (!monitor_running) {
-            break;  /* Check exit flag */
-        }
-        
-        if (ret > 0) {
-            /* Check which device has events */
-            for (int i = 0; i < 2; i++) {
-                if (pfd[i].revents & POLLIN) {
-                    /* Interrupt occurred, read interrupt count */
-                    if (read(pfd[i].fd, &irq_count, sizeof(irq_count)) == sizeof(irq_count)) {
-                        /* Dispatch to corresponding timer handler by device index */
-                        if (i == 0) {
-                            rtc_timer_tick_handler();   /* Timer0 handler */
-                        } else {
-                            rtc_timer_tick_handler2();  /* Timer1 handler */
-                        }
-                    } 
-                }
-            }
-        } 
+    rtc_trace_record_t *recs = malloc(sizeof(rtc_trace_record_t) * RTC_TRACE_RING_LEN);
+    if (!recs) {
+        return -1;
     }
-
-    printf("RTC interrupt monitoring thread exited\n");
-    return NULL;
+    int count = rtc_trace_ring_collect(&trace_ring, service, SERVICE_GEN(state), recs, RTC_TRACE_RING_LEN);
+    rtc_trace_summarize(recs, count, report);
+    free(recs);
+    return 0;
 }
 
-/* ========================= Private Helper Functions ========================= */
-
 /**
- * @brief Initialize timer service arrays
+ * @brief Get tick accounting statistics of a timer
  */
-static int init_timer_services(void) {
-    /* Initialize mutexes for all services */
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        if (pthread_mutex_init(&services_timer0[i].service_mutex, NULL) != 0) {
-            /* Cleanup already initialized mutexes */
-            for (int j = 0; j < i; j++) {
-                pthread_mutex_destroy(&services_timer0[j].service_mutex);
-            }
-            return -1;
-        }
-        
-        if (pthread_mutex_init(&services_timer1[i].service_mutex, NULL) != 0) {
-            /* Cleanup already initialized mutexes */
-            for (int j = 0; j <= i; j++) {
-                pthread_mutex_destroy(&services_timer0[j].service_mutex);
-            }
-            for (int j = 0; j < i; j++) {
-                pthread_mutex_destroy(&services_timer1[j].service_mutex);
-            }
-            return -1;
-        }
-        
-        /* Initialize service structures */
-        memset(&services_timer0[i], 0, sizeof(timer_service_t));
-        memset(&services_timer1[i], 0, sizeof(timer_service_t));
+int rtc_get_timer_stats(int timer_id, rtc_timer_stats_t *stats) {
+    if (!stats || !rtc_timer_valid(timer_id)) {
+        return -1;
     }
     
+    rtc_timer_t *timer = &rtc_timers[timer_id];
+    stats->ticks = atomic_load_explicit(&timer->ticks, memory_order_relaxed);
+    stats->wakeups = atomic_load_explicit(&timer->wakeups, memory_order_relaxed);
+    stats->missed_ticks = atomic_load_explicit(&timer->missed_ticks, memory_order_relaxed);
+    stats->coalesced_wakeups = atomic_load_explicit(&timer->coalesced_wakeups, memory_order_relaxed);
+    stats->max_gap = atomic_load_explicit(&timer->max_gap, memory_order_relaxed);
+    stats->last_irq_count = atomic_load_explicit(&timer->last_irq_count, memory_order_relaxed);
     return 0;
 }
 
 /**
- * @brief Cleanup timer services
+ * @brief Get the measured tick period and drift of a timer
  */
-static void cleanup_timer_services(void) {
-    /* Clear all services but don't destroy mutexes to avoid racing with exiting task threads */
-    pthread_mutex_lock(&rtc_mutex);
-    
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        /* Clear Timer0 services */
-        pthread_mutex_lock(&services_timer0[i].service_mutex);
-        services_timer0[i].callback_func = NULL;
-        services_timer0[i].threshold = 0;
-        services_timer0[i].count = 0;
-        services_timer0[i].is_running = 0;
-        services_timer0[i].service_name[0] = '\0';
-        pthread_mutex_unlock(&services_timer0[i].service_mutex);
-        
-        /* Clear Timer1 services */
-        pthread_mutex_lock(&services_timer1[i].service_mutex);
-        services_timer1[i].callback_func = NULL;
-        services_timer1[i].threshold = 0;
-        services_timer1[i].count = 0;
-        services_timer1[i].is_running = 0;
-        services_timer1[i].service_name[0] = '\0';
-        pthread_mutex_unlock(&services_timer1[i].service_mutex);
+int rtc_get_timer_drift(int timer_id, rtc_timer_drift_t *drift) {
+    if (!drift || !rtc_timer_valid(timer_id)) {
+        return -1;
     }
     
-    pthread_mutex_unlock(&rtc_mutex);
+    rtc_timer_t *timer = &rtc_timers[timer_id];
+    drift->tick_seconds = rtc_get_tick_seconds(timer_id);
+    drift->nominal_seconds = rtc_devices[timer_id].period_us / 1e6;
+    drift->drift_ppm = 0.0;
+    if (drift->tick_seconds > 0.0 && drift->nominal_seconds > 0.0) {
+        drift->drift_ppm = (drift->tick_seconds - drift->nominal_seconds) / drift->nominal_seconds * 1e6;
+    }
+    drift->windows = atomic_load_explicit(&timer->drift_windows, memory_order_relaxed);
+    return 0;
 }
 
 /**
- * @brief Get timer service array by timer ID
+ * @brief Get the measured real duration of one tick of a timer
  */
-static timer_service_t* get_timer_services(int timer_id) {
-    return (timer_id == 0) ? services_timer0 : services_timer1;
+double rtc_get_tick_seconds(int timer_id) {
+    if (!rtc_timer_valid(timer_id)) {
+        return 0.0;
+    }
+    return atomic_load_explicit(&rtc_timers[timer_id].tick_ps, memory_order_relaxed) / 1e12;
 }
 
-/* ========================= Public API Functions ========================= */
-
 /**
- * @brief Initialize RTC devices and monitoring thread
+ * @brief Select the tick backend of a timer
  */
-int rtc_init(void) {
-    pthread_mutex_lock(&rtc_mutex);
+int rtc_set_tick_backend(int timer_id, const struct rtc_tick_backend *backend, uint32_t period_us) {
+    if (!backend || timer_id < 0 || timer_id >= RTC_TIMER_MAX) {
+        printf("Invalid parameters for tick backend\n");
+        return -1;
+    }
     
-    /* Check if already initialized */
-    if (rtc_devices[0].is_initialized && rtc_devices[1].is_initialized) {
+    pthread_mutex_lock(&rtc_mutex);
+    rtc_device_t *dev = rtc_device_get(timer_id);
+    if (dev->is_initialized) {
         pthread_mutex_unlock(&rtc_mutex);
-        printf("RTC devices already initialized\n");
-        return 0;
+        printf("Tick backend must be set before rtc_init()\n");
+        return -1;
     }
+    dev->backend = backend;
+    dev->period_us = period_us;
+    pthread_mutex_unlock(&rtc_mutex);
     
-    /* Open RTC devices */
-    for (int i = 0; i < 2; i++) {
-        rtc_devices[i].fd = open(rtc_devices[i].device_path, O_RDWR);
-        if (rtc_devices[i].fd < 0) {
-            perror("Failed to open RTC device");
-            /* Close already opened devices */
-            for (int j = 0; j < i; j++) {
-                if (rtc_devices[j].fd >= 0) {
-                    close(rtc_devices[j].fd);
-                    rtc_devices[j].fd = -1;
-                    rtc_devices[j].is_initialized = 0;
-                }
-            }
-            pthread_mutex_unlock(&rtc_mutex);
-            return -1;
-        }
-        rtc_devices[i].is_initialized = 1;
-        printf("RTC device %s opened successfully (fd=%d)\n", 
-               rtc_devices[i].device_path, rtc_devices[i].fd);
-    }
+    printf("Timer%d uses the %s tick backend (period=%uus)\n", timer_id, backend->name, period_us);
+    return 0;
+}
 
-    /* Initialize timer services */
-    if (init_timer_services() != 0) {
-        perror("Failed to initialize timer services");
-        /* Close devices */
-        for (int i = 0; i < 2; i++) {
-            if (rtc_devices[i].fd >= 0) {
-                close(rtc_devices[i].fd);
-                rtc_devices[i].fd = -1;
-                rtc_devices[i].is_initialized = 0;
-            }
-        }
-        pthread_mutex_unlock(&rtc_mutex);
+/**
+ * @brief Switch a timer between periodic and tickless operation
+ */
+int rtc_set_tickless(int timer_id, int enable) {
+    if (timer_id < 0 || timer_id >= RTC_TIMER_MAX) {
+        printf("Invalid timer ID: %d\n", timer_id);
         return -1;
     }
     
-    /* Create interrupt monitoring thread */
-    monitor_running = 1;
-    if (pthread_create(&monitor_thread, NULL, rtc_irq_monitor_thread, NULL) != 0) {
-        perror("Failed to create RTC interrupt monitor thread");
-        /* Cleanup resources */
-        for (int i = 0; i < 2; i++) {
-            close(rtc_devices[i].fd);
-            rtc_devices[i].fd = -1;
-            rtc_devices[i].is_initialized = 0;
-        }
-        monitor_running = 0;
+    pthread_mutex_lock(&rtc_mutex);
+    rtc_device_t *dev = rtc_device_get(timer_id);
+    if (dev->is_initialized) {
         pthread_mutex_unlock(&rtc_mutex);
+        printf("Tickless mode must be set before rtc_init()\n");
         return -1;
     }
-    
+    if (enable && !dev->backend->oneshot) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("The %s tick backend has no one-shot mode\n", dev->backend->name);
+        return -1;
+    }
+    dev->tickless = enable ? 1 : 0;
     pthread_mutex_unlock(&rtc_mutex);
-    printf("RTC initialization completed successfully\n");
+    
+    printf("Timer%d %s\n", timer_id, enable ? "tickless" : "periodic");
     return 0;
 }
 
 /**
- * @brief Enable RTC interrupt via standard RTC ioctl
+ * @brief Set the scheduling attributes of the IRQ monitor thread
  */
-int rtc_enable_irq(int rtc_num) {
-    if (rtc_num < 0 || rtc_num > 1) {
-        printf("Invalid RTC number: %d\n", rtc_num);
-        return -1;
+int rtc_set_monitor_attr(const rtc_thread_attr_t *attr) {
+    rtc_thread_attr_t value = {0};
+    pthread_attr_t pattr;
+    int ret = 0;
+    
+    if (attr) {
+        value = *attr;
     }
     
-    const char* device_path = (rtc_num == 0) ? RTC_0 : RTC_1;
-    int fd = open(device_path, O_RDONLY);
-    if (fd < 0) {
-        perror("Failed to open RTC device");
+    /* Validate before storing so rtc_init() never meets bad attributes */
+    pthread_attr_init(&pattr);
+    ret = rtc_thread_attr_fill(&pattr, &value);
+    pthread_attr_destroy(&pattr);
+    if (ret != 0) {
         return -1;
     }
     
-    /* Enable interrupt using standard RTC interface */
-    int ret = ioctl(fd, RTC_VL_READ, 0);
-    close(fd);
+    pthread_mutex_lock(&rtc_mutex);
+    monitor_attr = value;
     
-    if (ret < 0) {
-        perror("Failed to enable RTC interrupt");
-        return -1;
+    if (atomic_load(&monitor_running)) {
+        struct sched_param param = {.sched_priority = value.sched_priority};
+        cpu_set_t set;
+        
+        ret = pthread_setschedparam(monitor_thread, value.sched_policy, &param);
+        if (ret == 0 && value.cpu_mask) {
+            CPU_ZERO(&set);
+            for (int cpu = 0; cpu < 64; cpu++) {
+                if (value.cpu_mask & (1ULL << cpu)) {
+                    CPU_SET(cpu, &set);
+                }
+            }
+            ret = pthread_setaffinity_np(monitor_thread, sizeof(set), &set);
+        }
+        if (ret != 0) {
+            printf("Failed to apply monitor thread attributes: %s\n", strerror(ret));
+            ret = -1;
+        }
     }
+    pthread_mutex_unlock(&rtc_mutex);
     
-    printf("RTC%d interrupt enabled successfully\n", rtc_num);
-    return 0;
+    return ret;
 }
 
 /**
- * @brief Disable RTC interrupt via standard RTC ioctl
+ * @brief Add a tick source feeding a timer
  */
-int rtc_disable_irq(int rtc_num) {
-    if (rtc_num < 0 || rtc_num > 1) {
-        printf("Invalid RTC number: %d\n", rtc_num);
+int rtc_add_tick_source(int timer_id, int fd) {
+    if (fd < 0 || !rtc_timer_valid(timer_id)) {
+        printf("Invalid parameters for tick source\n");
         return -1;
     }
     
-    const char* device_path = (rtc_num == 0) ? RTC_0 : RTC_1;
-    int fd = open(device_path, O_RDONLY);
-    if (fd < 0) {
-        perror("Failed to open RTC device");
+    rtc_ctl_msg_t msg = {.type = RTC_CTL_ADD_SOURCE, .fd = fd, .timer_id = timer_id};
+    if (rtc_monitor_request(&msg) != 0) {
+        printf("Failed to add tick source fd=%d to timer%d\n", fd, timer_id);
         return -1;
     }
     
-    /* Disable interrupt using standard RTC interface */
-    int ret = ioctl(fd, RTC_VL_CLR, 0);
-    close(fd);
+    printf("Tick source fd=%d added to timer%d\n", fd, timer_id);
+    return 0;
+}
+
+/**
+ * @brief Remove a tick source
+ */
+int rtc_remove_tick_source(int fd) {
+    if (fd < 0) {
+        return -1;
+    }
     
-    if (ret < 0) {
-        perror("Failed to disable RTC interrupt");
+    rtc_ctl_msg_t msg = {.type = RTC_CTL_REMOVE_SOURCE, .fd = fd};
+    if (rtc_monitor_request(&msg) != 0) {
+        printf("Failed to remove tick source fd=%d\n", fd);
         return -1;
     }
     
-    printf("RTC%d interrupt disabled successfully\n", rtc_num);
+    printf("Tick source fd=%d removed\n", fd);
     return 0;
 }
 
 /**
- * @brief Register a timer service
+ * @brief Publish tick counts to other local processes through shared memory
  */
-int rtc_register_service(int timer_id, const char *name, int interval, void (*callback_func)(void)) {
-    /* Parameter validation */
-    if (!name || !callback_func || interval <= 0 || timer_id < 0 || timer_id > 1) {
-        printf("Invalid parameters for service registration\n");
+int rtc_set_tick_publish(const char *shm_name) {
+    if (shm_name && (shm_name[0] != '/' || strlen(shm_name) >= sizeof(tick_shm_name))) {
+        printf("Invalid tick page name: %s\n", shm_name);
         return -1;
     }
     
-    if (strlen(name) >= MAX_SERVICE_NAME_LEN) {
-        printf("Service name too long (max %d chars)\n", MAX_SERVICE_NAME_LEN - 1);
+    pthread_mutex_lock(&rtc_mutex);
+    if (atomic_load(&rtc_timer_count) > 0) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("Tick publishing must be set before rtc_init()\n");
+        return -1;
+    }
+    if (shm_name) {
+        strcpy(tick_shm_name, shm_name);
+    } else {
+        tick_shm_name[0] = '\0';
+    }
+    pthread_mutex_unlock(&rtc_mutex);
+    return 0;
+}
+
+/**
+ * @brief Run services against simulated timers instead of the hardware tick
+ */
+int rtc_set_virtual_time(int timer_count) {
+    if (timer_count < 0 || timer_count > RTC_TIMER_MAX) {
+        printf("Invalid virtual timer count: %d\n", timer_count);
         return -1;
     }
     
     pthread_mutex_lock(&rtc_mutex);
-    
-    timer_service_t *services = get_timer_services(timer_id);
-    
-    /* Find free slot to register service */
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        if (!services[i].callback_func) {
-            /* Initialize service state */
-            pthread_mutex_lock(&services[i].service_mutex);
-            services[i].threshold = interval;
-            services[i].callback_func = callback_func;
-            services[i].count = 0;
-            services[i].is_running = 0;
-            strncpy(services[i].service_name, name, MAX_SERVICE_NAME_LEN - 1);
-            services[i].service_name[MAX_SERVICE_NAME_LEN - 1] = '\0';
-            pthread_mutex_unlock(&services[i].service_mutex);
-            
-            pthread_mutex_unlock(&rtc_mutex);
-            printf("Service '%s' registered successfully on timer%d (slot %d, interval=%d)\n", 
-                   name, timer_id, i, interval);
-            return 0;
+    if (atomic_load(&rtc_timer_count) > 0) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("Virtual time must be set before rtc_init()\n");
+        return -1;
+    }
+    /* Timers still on the nuclei default get emulated devices that never tick */
+    for (int i = 0; i < timer_count; i++) {
+        rtc_device_t *dev = rtc_device_get(i);
+        
+        if (dev->backend == &rtc_tick_backend_nuclei) {
+            dev->backend = &rtc_tick_backend_emu;
         }
     }
-    
+    virtual_timers = timer_count;
     pthread_mutex_unlock(&rtc_mutex);
-    printf("Failed to register service '%s' on timer%d: no available slots\n", name, timer_id);
-    return -1; 
+    return 0;
 }
 
 /**
- * @brief Unregister a timer service
+ * @brief Advance the virtual clock, running every service due on the way
  */
-int rtc_unregister_service(int timer_id, const char *name) {
-    /* Parameter validation */
-    if (!name || timer_id < 0 || timer_id > 1) {
-        printf("Invalid service name or timer_id\n");
+int rtc_virtual_run(uint64_t duration_ns) {
+    struct epoll_event events[RTC_MAX_TICK_SOURCES + 1];
+    
+    pthread_mutex_lock(&virtual_mutex);
+    if (!atomic_load(&virtual_time)) {
+        pthread_mutex_unlock(&virtual_mutex);
+        printf("RTC is not running in virtual time\n");
         return -1;
     }
     
-    pthread_mutex_lock(&rtc_mutex);
+    int count = atomic_load(&rtc_timer_count);
+    uint64_t now_ns = atomic_load_explicit(&virtual_now_ns, memory_order_relaxed);
+    if (duration_ns > UINT64_MAX - now_ns) {
+        pthread_mutex_unlock(&virtual_mutex);
+        printf("Virtual run of %llu ns overflows the clock\n", (unsigned long long)duration_ns);
+        return -1;
+    }
+    uint64_t end_ns = now_ns + duration_ns;
     
-    timer_service_t *services = get_timer_services(timer_id);
-    
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        if (services[i].callback_func && strcmp(services[i].service_name, name) == 0) {
-            /* Clear service slot */
-            pthread_mutex_lock(&services[i].service_mutex);
-            services[i].callback_func = NULL;
-            services[i].threshold = 0;
-            services[i].count = 0;
-            services[i].is_running = 0;
-            services[i].service_name[0] = '\0';
-            pthread_mutex_unlock(&services[i].service_mutex);
+    for (;;) {
+        /* Service changes and coroutine descriptors, as in the monitor loop; tick sources stay silent */
+        int ret = epoll_wait(monitor_epfd, events, RTC_MAX_TICK_SOURCES + 1, 0);
+        for (int i = 0; i < ret; i++) {
+            uint32_t id = events[i].data.u32;
             
-            pthread_mutex_unlock(&rtc_mutex);
-            printf("Service '%s' unregistered successfully from timer%d (slot %d)\n", 
-                   name, timer_id, i);
-            return 0;
+            if (id == RTC_CTL_EVENT_ID) {
+                rtc_monitor_handle_control();
+            } else if (id & RTC_CORO_EVENT_FLAG) {
+                rtc_monitor_coro_ready(id & ~RTC_CORO_EVENT_FLAG);
+            }
         }
+        
+        /* Jump straight to the earliest deadline over all timers */
+        uint64_t next_ns = UINT64_MAX;
+        for (int i = 0; i < count; i++) {
+            rtc_timer_apply_changes(&rtc_timers[i]);
+            
+            uint64_t next = rtc_wheel_next_expiry(&rtc_timers[i].wheel);
+            uint64_t tick_ns = rtc_virtual_tick_ns(i);
+            if (next <= UINT64_MAX / tick_ns && next * tick_ns < next_ns) {
+                next_ns = next * tick_ns;
+            }
+        }
+        if (next_ns > end_ns) {
+            break;
+        }
+        rtc_virtual_advance(count, next_ns);
     }
+    rtc_virtual_advance(count, end_ns);
     
-    pthread_mutex_unlock(&rtc_mutex);
-    printf("Service '%s' not found on timer%d\n", name, timer_id);
-    return -1;
+    pthread_mutex_unlock(&virtual_mutex);
+    return 0;
 }
 
 /**
- * @brief Get the number of registered services on the specified timer
+ * @brief Get the virtual clock
  */
-int rtc_get_service_count(int timer_id) {
-    if (timer_id < 0 || timer_id > 1) {
+uint64_t rtc_virtual_now_ns(void) {
+    return atomic_load_explicit(&virtual_now_ns, memory_order_relaxed);
+}
+
+/**
+ * @brief Set the number of callback executor threads
+ */
+int rtc_set_worker_pool_size(int pool_size) {
+    if (pool_size <= 0 || pool_size > RTC_WORKER_POOL_MAX) {
+        printf("Invalid executor pool size: %d (max %d)\n", pool_size, RTC_WORKER_POOL_MAX);
         return -1;
     }
     
     pthread_mutex_lock(&rtc_mutex);
-    timer_service_t *services = get_timer_services(timer_id);
-    
-    int count = 0;
-    for (int i = 0; i < MAX_SERVICES; i++) {
-        if (services[i].callback_func) {
-            count++;
-        }
+    if (worker_pool_running) {
+        pthread_mutex_unlock(&rtc_mutex);
+        printf("Executor pool size must be set before rtc_init()\n");
+        return -1;
+    }
+    worker_pool_size = pool_size;
+    pthread_mutex_unlock(&rtc_mutex);
+    return 0;
+}
+
+/**
+ * @brief Get callback executor pool statistics
+ */
+int rtc_get_pool_stats(rtc_pool_stats_t *stats) {
+    if (!stats) {
+        return -1;
     }
     
+    pthread_mutex_lock(&rtc_mutex);
+    if (!worker_pool_running) {
+        pthread_mutex_unlock(&rtc_mutex);
+        return -1;
+    }
+    rtc_executor_get_stats(&worker_pool, stats);
     pthread_mutex_unlock(&rtc_mutex);
-    return count;
+    return 0;
 }
 
 /**
  * @brief Check if RTC devices are initialized
  */
 int rtc_is_initialized(void) {
-    return (rtc_devices[0].is_initialized && rtc_devices[1].is_initialized) ? 1 : 0;
+    return (atomic_load(&rtc_timer_count) > 0) ? 1 : 0;
+}
+
+/**
+ * @brief Get the number of timers discovered by rtc_init()
+ */
+int rtc_get_timer_count(void) {
+    return atomic_load(&rtc_timer_count);
 }
 
 /**
  * @brief Cleanup RTC devices and services
  */
 void rtc_cleanup(void) {
-    /* Stop monitoring thread */
-    if (monitor_running) {
-        monitor_running = 0;
-        pthread_cancel(monitor_thread);
+    /* A virtual-time run on another thread returns first */
+    if (atomic_load(&virtual_time)) {
+        pthread_mutex_lock(&virtual_mutex);
+        atomic_store(&virtual_time, 0);
+        atomic_store(&virtual_now_ns, 0);
+        pthread_mutex_unlock(&virtual_mutex);
+    }
+    
+    /* Stop monitoring thread: the eventfd wakes it out of epoll_wait */
+    if (atomic_exchange(&monitor_running, 0)) {
+        pthread_mutex_lock(&ctl_mutex);
+        rtc_monitor_notify();
+        pthread_mutex_unlock(&ctl_mutex);
         pthread_join(monitor_thread, NULL);
+
+        /* Fail requests the monitor left behind instead of letting them time out */
+        pthread_mutex_lock(&ctl_mutex);
+        for (rtc_ctl_msg_t *msg = ctl_queue; msg; msg = msg->next) {
+            msg->result = -1;
+            msg->done = 1;
+        }
+        ctl_queue = NULL;
+        pthread_cond_broadcast(&ctl_cond);
+        pthread_mutex_unlock(&ctl_mutex);
         printf("RTC monitor thread stopped\n");
     }
     
-    /* Close devices */
-    for (int i = 0; i < 2; i++) {
-        if (rtc_devices[i].fd >= 0) {
-            close(rtc_devices[i].fd);
-            rtc_devices[i].fd = -1;
-            rtc_devices[i].is_initialized = 0;
-            printf("RTC device %s closed\n", rtc_devices[i].device_path);
-        }
+    /* Subscribers see the page close and wait for a new publisher */
+    if (tick_shm) {
+        rtc_tick_shm_destroy(tick_shm, tick_shm_name);
+        tick_shm = NULL;
+    }
+    
+    /* Stop executor pool; waits for queued and running callbacks */
+    if (worker_pool_running) {
+        rtc_executor_stop(&worker_pool);
+        worker_pool_running = 0;
+        printf("RTC executor pool stopped\n");
     }
     
+    /* Close monitor descriptors and devices */
+    rtc_monitor_close();
+    close_rtc_devices();
+    
     /* Cleanup services */
     cleanup_timer_services();
     
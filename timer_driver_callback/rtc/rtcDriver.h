@@ -8,41 +8,303 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdatomic.h>
 #include <poll.h>
 #include <signal.h>
 #include <pthread.h>
 #include <linux/rtc.h>
 #include "dis_dfe8219_board.h"
+#include "rtcTimerWheel.h"
+#include "rtcCoroutine.h"
 
 /* ========================= Macro Definitions ========================= */
-#define RTC_0 "/dev/rtc0"
-#define RTC_1 "/dev/rtc1"
+#define RTC_DEV_FMT "/dev/rtc%d"
 
-/* Nuclei RTC character device paths */
-#define NUCLEI_RTC_CHR_DEV0 "/dev/nuclei_rtc0"
-#define NUCLEI_RTC_CHR_DEV1 "/dev/nuclei_rtc1"
+/* Nuclei RTC character device paths, numbered in kernel probe order */
+#define NUCLEI_RTC_CHR_DEV_FMT "/dev/nuclei_rtc%d"
 
 /* Configuration parameters */
-#define MAX_SERVICES 10             /* Maximum number of supported services */
+#define RTC_TIMER_MAX 8             /* Maximum number of hardware timers */
+#define RTC_SERVICE_CHUNK_SIZE 64   /* Service slots allocated at a time */
+#define RTC_SERVICE_CHUNKS 16       /* Maximum number of slot chunks (1024 services) */
+#define RTC_SERVICE_HASH_SIZE 256   /* Name lookup buckets (power of two) */
+#define RTC_LATENCY_HIST_BUCKETS 16 /* Start-latency histogram buckets (log2 of microseconds) */
+#define RTC_MAX_TICK_SOURCES 16     /* Maximum number of tick sources watched by the monitor */
+#define RTC_MONITOR_WAIT_MS 500     /* Upper bound on a monitor wait when no event arrives */
+#define RTC_MONITOR_CTL_TIMEOUT_MS 1000 /* Maximum time to wait for the monitor to apply a control request */
 #define MAX_SERVICE_NAME_LEN 32     /* Maximum service name length */
+#define RTC_PHASE_AUTO (-1)         /* Let the driver stagger services sharing a period */
+#define RTC_PIPELINE_MAX_STAGES 8   /* Maximum number of stages in a service pipeline */
+#define RTC_WORKER_POOL_SIZE 2      /* Default number of callback executor threads */
+#define RTC_WORKER_POOL_MAX 16      /* Maximum number of callback executor threads */
+#define RTC_WORKER_QUEUE_LEN 64     /* Maximum number of callbacks waiting for an executor */
+#define RTC_STRAND_MAX 8            /* Maximum number of named strands */
+#define RTC_BUDGET_SETTLE_MS 1000   /* Service age before its measured CPU share counts for admission */
+#define RTC_TRACE_RING_LEN 1024     /* Latency trace records kept (power of two) */
+#define RTC_DRIFT_WINDOW_MS 10000   /* Wall time over which one tick-period measurement is taken */
+#define RTC_DRIFT_MIN_TICKS 8       /* Ticks before a first, provisional tick period is published */
+#define RTC_DRIFT_SMOOTHING 4       /* Each window moves the estimate by 1/N of its difference */
+#define RTC_VIRTUAL_TICK_US 1000    /* Tick period of a simulated timer configured without one */
 
 /* ========================= Data Structures ========================= */
 
+/**
+ * @brief How a service catches up on firings missed while the monitor thread was delayed
+ */
+typedef enum {
+    RTC_CATCHUP_COALESCE = 0,       /* Run once for all missed firings (default) */
+    RTC_CATCHUP_SKIP,               /* Drop late firings, run only on time */
+    RTC_CATCHUP_REPLAY              /* Run once per missed firing, up to a limit */
+} rtc_catchup_policy_t;
+
+/**
+ * @brief What happens to a firing that finds the previous callback still running
+ */
+typedef enum {
+    RTC_OVERRUN_RETRY = 0,          /* Retry on every tick until the callback returns (default) */
+    RTC_OVERRUN_SKIP,               /* Drop the firing and wait for the next deadline */
+    RTC_OVERRUN_QUEUE_ONE,          /* Keep the first such firing, run it as soon as the callback returns */
+    RTC_OVERRUN_COALESCE            /* Merge all such firings into one run as soon as the callback returns */
+} rtc_overrun_policy_t;
+
+/**
+ * @brief What happens to a registration or budget that would exceed a timer's utilization ceiling
+ */
+typedef enum {
+    RTC_ADMISSION_OFF = 0,          /* No check (default) */
+    RTC_ADMISSION_WARN,             /* Accept and print a warning */
+    RTC_ADMISSION_ENFORCE           /* Reject */
+} rtc_admission_policy_t;
+
+/**
+ * @brief Scheduling attributes for a callback or monitor thread
+ *
+ * A zero-initialized structure means default attributes: SCHED_OTHER, any
+ * CPU and the default stack size.
+ */
+typedef struct {
+    int sched_policy;               /* SCHED_OTHER, SCHED_FIFO or SCHED_RR */
+    int sched_priority;             /* Priority for SCHED_FIFO/SCHED_RR (1 ~ 99), 0 for SCHED_OTHER */
+    uint64_t cpu_mask;              /* Bit n allows CPU n; 0 keeps the inherited affinity */
+    size_t stack_size;              /* Thread stack size in bytes, 0 for the default */
+} rtc_thread_attr_t;
+
+/**
+ * @brief Tick information passed to service callbacks
+ */
+typedef struct {
+    uint64_t timestamp_ns;          /* CLOCK_MONOTONIC time of the wakeup that dispatched the call */
+    uint64_t sequence;              /* Timer tick number the call belongs to */
+    uint32_t missed_ticks;          /* Timer ticks that arrived without a wakeup of their own */
+    uint32_t skipped;               /* Firings of this service dropped by its catch-up policy */
+    uint32_t overruns;              /* Firings that came due while the previous call was running,
+                                       covered by this call or dropped since the last one */
+    double tick_seconds;            /* Measured real duration of one timer tick, 0 until known */
+} rtc_tick_info_t;
+
+/**
+ * @brief Service callback carrying the context given at registration
+ */
+typedef void (*rtc_service_callback_t)(void *ctx, const rtc_tick_info_t *info);
+
+/**
+ * @brief Self-rescheduling service callback
+ *
+ * @return uint32_t Ticks from info->sequence to the next run, 0 to keep the period
+ */
+typedef uint32_t (*rtc_service_resched_t)(void *ctx, const rtc_tick_info_t *info);
+
+/**
+ * @brief Coroutine service body (see rtcCoroutine.h)
+ *
+ * @return rtc_coro_status_t What the coroutine waits for before its next step
+ */
+typedef rtc_coro_status_t (*rtc_coro_func_t)(rtc_coro_t *co, void *ctx, const rtc_tick_info_t *info);
+
+/**
+ * @brief Stage of a service pipeline
+ */
+typedef struct {
+    const char *name;               /* Stage name, copied at registration */
+    rtc_service_callback_t callback;/* Stage function */
+    void *ctx;                      /* Context passed to the stage */
+    int decimation;                 /* Run on every Nth pipeline run, 0 or 1 for every run */
+} rtc_pipeline_stage_t;
+
+/**
+ * @brief Overrun report passed to a service's overrun alarm
+ */
+typedef struct {
+    const char *name;               /* Service name */
+    int timer_id;                   /* Timer index */
+    rtc_overrun_policy_t policy;    /* Policy applied to the overrun firings */
+    uint64_t sequence;              /* Tick number of the call that overran */
+    uint64_t runtime_ns;            /* Runtime of the call that overran */
+    uint32_t overruns;              /* Firings that found the call still running */
+} rtc_overrun_event_t;
+
+/**
+ * @brief Overrun alarm, called on the service's executor when an overrunning call returns
+ */
+typedef void (*rtc_overrun_alarm_t)(void *ctx, const rtc_overrun_event_t *event);
+
+/**
+ * @brief Always-on service counters, updated with relaxed atomics
+ *
+ * Written by the monitor thread at dispatch and by the executor running the
+ * callback; never both for the same field.
+ */
+typedef struct {
+    atomic_uint_least64_t dispatches;                       /* Jobs queued for the service */
+    atomic_uint_least64_t runs;                             /* Callback runs */
+    atomic_uint_least64_t overruns;                         /* Expiries deferred because the callback was still running */
+    atomic_uint_least64_t overrun_dropped;                  /* Overrun firings dropped by the overrun policy */
+    atomic_uint_least64_t late_dropped;                     /* Late firings not run due to the catch-up policy */
+    atomic_uint_least64_t runtime_last_ns;                  /* Last callback runtime */
+    atomic_uint_least64_t runtime_min_ns;                   /* Shortest callback runtime */
+    atomic_uint_least64_t runtime_max_ns;                   /* Longest callback runtime */
+    atomic_uint_least64_t runtime_total_ns;                 /* Sum of callback runtimes */
+    atomic_uint_least64_t budget_overruns;                  /* Runs longer than the declared budget */
+    atomic_uint_least64_t slack_early;                      /* Firings run early in their slack window with another dispatch */
+    atomic_uint_least32_t latency_hist[RTC_LATENCY_HIST_BUCKETS]; /* Tick-to-start latency histogram */
+} rtc_service_counters_t;
+
 /**
  * @brief Timer service structure
  * 
  * This structure manages each registered timer service, including service
- * state information, callback function pointers, and mutexes for thread safety.
+ * state information and the callback function pointer. Services live in
+ * slots that are never freed while the driver is running; a slot is only
+ * recycled once neither the timing wheel nor an executor references it.
+ *
+ * state packs a generation counter with the slot phase (free, claimed,
+ * active, retiring) so lookups can detect a slot recycled under them.
+ * The timing wheel entry is owned by the IRQ monitor thread; registration
+ * changes reach it through the timer's pending-change stack.
  */
-typedef struct {
-    int count;                                  /* Current count value */
-    int threshold;                              /* Trigger threshold */
-    void (*callback_func)(void);                /* Callback function pointer */
+typedef struct timer_service {
+    rtc_wheel_node_t wheel_node;                /* Timing wheel entry (monitor thread only) */
+    struct timer_service *pending_next;         /* Next entry on the pending-change stack */
+    struct timer_service *hash_next;            /* Next entry in the name lookup bucket */
+    atomic_uint pending;                        /* Queued on the pending-change stack */
+    atomic_uint state;                          /* Generation << 2 | slot phase */
+    atomic_uint refs;                           /* Wheel / running references */
+    struct timer_service *due_next;             /* Next service due in the current wakeup (monitor only) */
+    uint64_t next_due;                          /* Next on-period expiry tick (monitor only) */
+    uint32_t due_count;                         /* Expiries in the current wakeup (monitor only) */
+    atomic_int slack;                           /* Requested slack in ticks */
+    uint32_t slack_ticks;                       /* Slack in effect (monitor only) */
+    struct timer_service *slack_next;           /* Next service with slack on the timer (monitor only) */
+    struct timer_service *batch_next;           /* Next service of the same batched job */
+    uint64_t due_tick;                          /* Last expiry tick in the current wakeup (monitor only) */
+    uint32_t run_count;                         /* Callback runs for the queued job */
+    uint64_t tick_ns;                           /* Wakeup time of the tick that queued the job */
+    uint64_t tick_seq;                          /* Tick number that queued the job */
+    uint32_t tick_missed;                       /* Missed timer ticks in the wakeup that queued the job */
+    uint32_t tick_skipped;                      /* Firings dropped for the queued job */
+    atomic_int catchup_policy;                  /* rtc_catchup_policy_t */
+    atomic_uint catchup_max;                    /* Run limit for RTC_CATCHUP_REPLAY */
+    atomic_int overrun_policy;                  /* rtc_overrun_policy_t */
+    _Atomic(rtc_overrun_alarm_t) overrun_alarm; /* Overrun alarm, NULL for none */
+    _Atomic(void *) overrun_ctx;                /* Context passed to the overrun alarm */
+    atomic_uint overrun_events;                 /* Overruns seen during the current call */
+    atomic_uint overrun_lost;                   /* Overrun firings dropped since the last call */
+    atomic_uint_least64_t owed_seq;             /* Tick of the firing owed after the current call */
+    int timer_id;                               /* Owning timer index */
+    int threshold;                              /* Trigger interval in ticks in effect (monitor only) */
+    atomic_int interval;                        /* Requested trigger interval in ticks */
+    atomic_int phase;                           /* Expiry tick modulo interval */
+    rtc_service_callback_t callback;            /* Callback function pointer */
+    void *ctx;                                  /* Context passed to the callback */
+    void (*callback_func)(void);                /* Callback of services registered without context */
+    rtc_service_resched_t resched_func;         /* Callback of self-rescheduling services */
+    void *resched_ctx;                          /* Context passed to resched_func */
+    atomic_uint_least64_t resched_due;          /* Tick requested by resched_func, 0 for none */
+    struct rtc_executor *executor;              /* Dedicated executor, NULL for the shared pool */
+    _Atomic(struct rtc_strand *) strand;        /* Serial executor shared with other services, NULL for none */
+    atomic_uint_least64_t budget_ns;            /* Declared CPU cost per run, 0 for none */
+    atomic_int budget_warned;                   /* A budget overrun has been reported */
+    uint64_t registered_ns;                     /* Registration time, start of the measured CPU share */
+    struct rtc_pipeline *pipeline;              /* Stages run by a pipeline service, NULL otherwise */
+    rtc_coro_func_t coro_func;                  /* Body of a coroutine service, NULL otherwise */
+    void *coro_ctx;                             /* Context passed to coro_func */
+    rtc_coro_t coro;                            /* Coroutine state (executor holding the service only) */
+    atomic_int coro_wait_fd;                    /* Descriptor the coroutine asked to await, -1 for none */
+    atomic_int coro_fd_ready;                   /* The awaited descriptor became readable */
+    int coro_watch_fd;                          /* Descriptor in the monitor's epoll set, -1 for none (monitor only) */
+    uint32_t slot_index;                        /* Position in the slot table */
+    atomic_int trace;                           /* Record latency traces of the service's runs */
+    uint64_t trace_irq_ns;                      /* Interrupt time of the traced job, 0 if unknown */
+    uint64_t trace_wakeup_ns;                   /* Monitor wakeup of the traced job */
+    uint64_t trace_dispatch_ns;                 /* Queue time of the traced job, 0 when not traced */
     char service_name[MAX_SERVICE_NAME_LEN];    /* Service name */
-    pthread_mutex_t service_mutex;              /* Mutex to protect individual service state */
-    int is_running;                             /* Running state flag */
+    rtc_service_counters_t stats;               /* Execution statistics */
 } timer_service_t;
 
+/**
+ * @brief Snapshot of a service's execution statistics
+ *
+ * latency_hist[0] counts starts within 2us of the tick; latency_hist[i]
+ * counts starts in [2^i, 2^(i+1)) us; the last bucket is open-ended.
+ */
+typedef struct {
+    char name[MAX_SERVICE_NAME_LEN];                /* Service name */
+    int interval;                                   /* Trigger interval in ticks */
+    int phase;                                      /* Expiry tick modulo interval */
+    char strand[MAX_SERVICE_NAME_LEN];              /* Strand the service runs on, empty for none */
+    uint64_t dispatches;                            /* Jobs queued for the service */
+    uint64_t runs;                                  /* Callback runs */
+    uint64_t overruns;                              /* Expiries deferred because the callback was still running */
+    uint64_t overrun_dropped;                       /* Overrun firings dropped by the overrun policy */
+    uint64_t late_dropped;                          /* Late firings not run due to the catch-up policy */
+    uint64_t budget_ns;                             /* Declared CPU cost per run, 0 for none */
+    uint64_t budget_overruns;                       /* Runs longer than the declared budget */
+    int slack;                                      /* Ticks a firing may be delayed to share a wakeup */
+    uint64_t slack_early;                           /* Firings run early in their slack window with another dispatch */
+    uint64_t runtime_last_ns;                       /* Last callback runtime */
+    uint64_t runtime_min_ns;                        /* Shortest callback runtime (0 before the first run) */
+    uint64_t runtime_max_ns;                        /* Longest callback runtime */
+    uint64_t runtime_mean_ns;                       /* Mean callback runtime */
+    uint32_t latency_hist[RTC_LATENCY_HIST_BUCKETS];/* Tick-to-start latency histogram */
+} rtc_service_stats_t;
+
+/**
+ * @brief Per-timer tick accounting statistics
+ */
+typedef struct {
+    uint64_t ticks;                     /* Hardware ticks accounted */
+    uint64_t wakeups;                   /* Monitor wakeups carrying at least one tick */
+    uint64_t missed_ticks;              /* Ticks that arrived without a wakeup of their own */
+    uint64_t coalesced_wakeups;         /* Wakeups that covered more than one tick */
+    uint32_t max_gap;                   /* Most ticks covered by a single wakeup */
+    unsigned long last_irq_count;       /* Last cumulative interrupt count read from the kernel */
+} rtc_timer_stats_t;
+
+/**
+ * @brief Per-timer service management structure
+ */
+typedef struct {
+    rtc_timer_wheel_t wheel;                    /* Timing wheel (monitor thread only) */
+    timer_service_t *slack_list;                /* Services with slack, chained through slack_next (monitor only) */
+    _Atomic(timer_service_t *) pending;         /* Services with unapplied registration changes */
+    atomic_int service_count;                   /* Number of registered services */
+    atomic_ulong last_irq_count;                /* Last cumulative interrupt count */
+    atomic_uint_least64_t ticks;                /* Hardware ticks accounted */
+    atomic_uint_least64_t wakeups;              /* Wakeups carrying at least one tick */
+    atomic_uint_least64_t missed_ticks;         /* Ticks without a wakeup of their own */
+    atomic_uint_least64_t coalesced_wakeups;    /* Wakeups covering more than one tick */
+    atomic_uint max_gap;                        /* Most ticks covered by one wakeup */
+    atomic_int traced;                          /* Services with latency tracing enabled */
+    uint64_t irq_ns;                            /* Interrupt time of the current wakeup (monitor only) */
+    uint64_t wakeup_ns;                         /* epoll return of the current wakeup (monitor only) */
+    uint64_t drift_ref_ns;                      /* Start of the current drift window, 0 before the first tick (monitor only) */
+    uint64_t drift_ref_ticks;                   /* Ticks accounted at the start of the window (monitor only) */
+    atomic_uint_least64_t tick_ps;              /* Measured tick period in picoseconds, 0 until known */
+    atomic_uint_least64_t drift_windows;        /* Completed drift windows */
+    atomic_uint ceiling_permille;               /* Utilization ceiling of the services, 0 for none */
+    atomic_int admission;                       /* rtc_admission_policy_t */
+} rtc_timer_t;
+
 /**
  * @brief RTC device management structure
  * 
@@ -52,8 +314,86 @@ typedef struct {
     int fd;                         /* Device file descriptor */
     char device_path[64];           /* Device path */
     int is_initialized;             /* Initialization state */
+    int id;                         /* Device index */
+    const struct rtc_tick_backend *backend; /* Tick backend driving the device (see rtcTickBackend.h) */
+    uint32_t period_us;             /* Tick period requested from the backend, 0 for its default */
+    int tickless;                   /* Program one tick per service deadline instead of every period */
+    void *priv;                     /* Backend private state */
 } rtc_device_t;
 
+/**
+ * @brief Callback executor pool statistics
+ */
+typedef struct {
+    int pool_size;                      /* Number of executor threads */
+    uint32_t queue_depth;               /* Callbacks currently waiting for an executor */
+    uint32_t queue_depth_max;           /* Highest queue depth observed */
+    uint64_t dispatched;                /* Callbacks queued */
+    uint64_t started;                   /* Callbacks picked up by an executor */
+    uint64_t dropped;                   /* Callbacks rejected because the queue was full */
+    uint64_t start_latency_last_ns;     /* Last dispatch-to-start time */
+    uint64_t start_latency_max_ns;      /* Maximum dispatch-to-start time */
+    uint64_t start_latency_total_ns;    /* Sum of dispatch-to-start times (mean = total / started) */
+} rtc_pool_stats_t;
+
+/**
+ * @brief Measured tick period of a timer against CLOCK_MONOTONIC
+ */
+typedef struct {
+    double tick_seconds;                /* Measured real duration of one tick, 0 until known */
+    double nominal_seconds;             /* Period requested from the tick backend, 0 if set by the device */
+    double drift_ppm;                   /* Measured against nominal in parts per million, 0 if either is unknown */
+    uint64_t windows;                   /* Completed measurement windows, 0 while provisional */
+} rtc_timer_drift_t;
+
+/**
+ * @brief CPU share of a timer's services, in permille of one CPU
+ *
+ * A service counts with its declared budget per period or its measured
+ * runtime per second of age, whichever is higher; measurements start to
+ * count after RTC_BUDGET_SETTLE_MS.
+ */
+typedef struct {
+    uint32_t ceiling_permille;          /* Configured ceiling, 0 for none */
+    rtc_admission_policy_t policy;      /* Admission policy */
+    uint32_t declared_permille;         /* Sum of declared budgets */
+    uint32_t measured_permille;         /* Sum of measured runtimes */
+    uint32_t admitted_permille;         /* Sum used for admission */
+    int over_budget;                    /* Services that have run longer than their budget */
+} rtc_timer_utilization_t;
+
+/**
+ * @brief Hops of the tick-to-actuation path measured by latency tracing
+ */
+typedef enum {
+    RTC_TRACE_STAGE_IRQ = 0,        /* Interrupt to monitor wakeup */
+    RTC_TRACE_STAGE_READ,           /* Wakeup to tick handler (count read and accounting) */
+    RTC_TRACE_STAGE_DISPATCH,       /* Tick handler to job queued (wheel walk) */
+    RTC_TRACE_STAGE_QUEUE,          /* Job queued to executor start */
+    RTC_TRACE_STAGE_CALLBACK,       /* Executor start to rtc_trace_mark() or callback return */
+    RTC_TRACE_STAGE_TOTAL,          /* Interrupt (wakeup if unknown) to rtc_trace_mark() or return */
+    RTC_TRACE_STAGES
+} rtc_trace_stage_t;
+
+/**
+ * @brief Latency percentiles of one stage
+ */
+typedef struct {
+    uint32_t samples;                   /* Records with both ends of the stage stamped */
+    uint64_t p50_ns;                    /* Median */
+    uint64_t p90_ns;                    /* 90th percentile */
+    uint64_t p99_ns;                    /* 99th percentile */
+    uint64_t max_ns;                    /* Maximum */
+} rtc_trace_stage_stats_t;
+
+/**
+ * @brief Latency report of a traced service, over the records still in the trace ring
+ */
+typedef struct {
+    uint32_t records;                                   /* Trace records summarized */
+    rtc_trace_stage_stats_t stage[RTC_TRACE_STAGES];    /* Indexed by rtc_trace_stage_t */
+} rtc_trace_report_t;
+
 /* ========================= Function Declarations ========================= */
 
 /**
@@ -63,10 +403,20 @@ typedef struct {
  *         - 0: Initialization successful
  *         - negative: Initialization failed
  *
- * @note This function opens RTC character devices and starts interrupt monitoring thread
+ * @note This function opens RTC character devices and starts interrupt monitoring thread.
+ *       Timers are discovered in order: timer N exists if it was given a
+ *       non-nuclei backend with rtc_set_tick_backend() or /dev/nuclei_rtcN
+ *       exists, and discovery stops at the first timer that does not.
  */
 int rtc_init(void);
 
+/**
+ * @brief Get the number of timers discovered by rtc_init()
+ *
+ * @return int Number of timers, 0 if RTC is not initialized
+ */
+int rtc_get_timer_count(void);
+
 /**
  * @brief Cleanup RTC devices
  *
@@ -80,7 +430,7 @@ void rtc_cleanup(void);
 /**
  * @brief Enable interrupts for the specified RTC device
  *
- * @param rtc_num RTC device index to operate on (0 or 1)
+ * @param rtc_num RTC device index to operate on (0 ~ rtc_get_timer_count() - 1)
  * @return int Result code
  *         - 0: Interrupt enabled successfully
  *         - negative: Operation failed
@@ -90,7 +440,7 @@ int rtc_enable_irq(int rtc_num);
 /**
  * @brief Disable interrupts for the specified RTC device
  *
- * @param rtc_num RTC device index to operate on (0 or 1)
+ * @param rtc_num RTC device index to operate on (0 ~ rtc_get_timer_count() - 1)
  * @return int Result code
  *         - 0: Interrupt disabled successfully
  *         - negative: Operation failed
@@ -101,23 +451,149 @@ int rtc_disable_irq(int rtc_num);
 /**
  * @brief Register a timer service
  *
- * @param timer_id Timer index (0 or 1)
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
  * @param name Service name
  * @param interval Trigger interval
- * @param callback_func Callback function invoked in a detached thread when triggered
+ * @param callback_func Callback function invoked on an executor thread when triggered
  * @return int Result code
  *         - 0: Registration successful
- *         - -1: Registration failed (no available slot or invalid parameters)
+ *         - -1: Registration failed (duplicate name, no available slot or invalid parameters)
  *
- * @note Each trigger spawns a temporary thread to execute the callback. The
- *       thread exits automatically after completion; no lifecycle management needed.
+ * @note Each trigger queues the callback to the executor pool. A service is never
+ *       queued again while its previous callback is still pending or running.
+ *       Services sharing an interval are staggered automatically (RTC_PHASE_AUTO).
  */
 int rtc_register_service(int timer_id, const char *name, int interval, void (*callback_func)(void));
 
+/**
+ * @brief Register a timer service whose callback takes a context and tick information
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name, unique per timer
+ * @param interval Trigger interval
+ * @param callback Callback function invoked on an executor thread when triggered
+ * @param ctx Context passed to the callback, owned by the caller
+ * @return int Result code
+ *         - 0: Registration successful
+ *         - -1: Registration failed (duplicate name, no available slot or invalid parameters)
+ *
+ * @note The context lets one callback serve several independent instances.
+ *       ctx must stay valid until the service is unregistered and its last
+ *       callback has returned.
+ */
+int rtc_register_service_ctx(int timer_id, const char *name, int interval,
+                             rtc_service_callback_t callback, void *ctx);
+
+/**
+ * @brief Register a timer service with a phase, its own scheduling attributes and a CPU budget
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param interval Trigger interval
+ * @param phase Tick offset within the period (0 ~ interval-1): the service
+ *              expires on timer ticks where tick % interval == phase.
+ *              RTC_PHASE_AUTO spreads services sharing a period evenly.
+ * @param callback Callback function invoked when triggered
+ * @param ctx Context passed to the callback
+ * @param attr Scheduling attributes of the callback thread, NULL for the shared pool
+ * @param budget_us Declared cost per run in microseconds, 0 for none
+ * @return int Result code
+ *         - 0: Registration successful (possibly with an admission warning)
+ *         - -1: Registration failed (no available slot, invalid parameters,
+ *               the callback thread could not be created with the attributes,
+ *               or the budget would exceed the timer's ceiling under
+ *               RTC_ADMISSION_ENFORCE)
+ *
+ * @note With attr set, the callback runs on a dedicated executor thread created
+ *       with the given policy, priority, CPU mask and stack size, so it never
+ *       queues behind callbacks of other services. SCHED_FIFO and SCHED_RR
+ *       require CAP_SYS_NICE. The thread is stopped once the service is
+ *       unregistered and its last running callback has returned.
+ */
+int rtc_register_service_ex(int timer_id, const char *name, int interval, int phase,
+                            rtc_service_callback_t callback, void *ctx, const rtc_thread_attr_t *attr,
+                            uint32_t budget_us);
+
+/**
+ * @brief Register a service whose callback chooses the delay to its next run
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param interval Default period, used whenever the callback returns 0
+ * @param phase Tick offset of the first run within the period, or RTC_PHASE_AUTO
+ * @param callback Callback returning the ticks from info->sequence to its next run
+ * @param ctx Context passed to the callback
+ * @param attr Scheduling attributes of the callback thread, NULL for the shared pool
+ * @return int Result code
+ *         - 0: Registration successful
+ *         - -1: Registration failed (see rtc_register_service_ex())
+ *
+ * @note The delay reaches the monitor thread through the service's lock-free
+ *       change queue and re-times its wheel entry; rtc_mutex is not taken.
+ *       It applies once the callback has returned, so a delay shorter than
+ *       the callback's own runtime makes the next run follow immediately,
+ *       and a default period expiring first still runs once.
+ */
+int rtc_register_service_resched(int timer_id, const char *name, int interval, int phase,
+                                 rtc_service_resched_t callback, void *ctx,
+                                 const rtc_thread_attr_t *attr);
+
+/**
+ * @brief Register a stackless coroutine service
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param interval Period at which a finished coroutine starts again
+ * @param phase Tick offset of the first run within the period, or RTC_PHASE_AUTO
+ * @param func Coroutine body written with the RTC_CORO_* macros
+ * @param ctx Context passed to the body; holds all state kept across awaits
+ * @param attr Scheduling attributes of the coroutine thread, NULL for the shared pool
+ * @return int Result code
+ *         - 0: Registration successful
+ *         - -1: Registration failed (see rtc_register_service_ex())
+ *
+ * @note Each step runs as an ordinary callback job and returns at its next
+ *       await, so any number of waiting coroutines share one executor.
+ *       A tick wait re-times the service like rtc_register_service_resched(),
+ *       and a firing that comes early does not resume the coroutine. An fd
+ *       wait takes the service off the timing wheel and adds the descriptor
+ *       to the monitor's epoll set; the step is dispatched when it becomes
+ *       readable and the period restarts from there. A descriptor may only
+ *       be awaited by one coroutine at a time; if it cannot be watched the
+ *       coroutine resumes on its next period.
+ */
+int rtc_register_coroutine(int timer_id, const char *name, int interval, int phase,
+                           rtc_coro_func_t func, void *ctx, const rtc_thread_attr_t *attr);
+
+/**
+ * @brief Register a service that runs a pipeline of stages in order on every firing
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param interval Trigger interval of the pipeline
+ * @param phase Tick offset within the period, or RTC_PHASE_AUTO
+ * @param stages Stages in execution order; copied
+ * @param stage_count Number of stages (1 ~ RTC_PIPELINE_MAX_STAGES)
+ * @param attr Scheduling attributes of the pipeline thread, NULL for the shared pool
+ * @return int Result code
+ *         - 0: Registration successful
+ *         - -1: Registration failed (see rtc_register_service_ex())
+ *
+ * @note All stages of one firing run back to back in one callback job, so a
+ *       stage always sees the complete output of the stages before it, and
+ *       the next firing never starts before the last stage returned. A stage
+ *       with decimation N runs on the first pipeline run and every Nth run
+ *       after it, e.g. acquisition every tick and control every tenth.
+ *       Overrun, catch-up and statistics apply to the pipeline as a whole.
+ */
+int rtc_register_pipeline(int timer_id, const char *name, int interval, int phase,
+                          const rtc_pipeline_stage_t *stages, int stage_count,
+                          const rtc_thread_attr_t *attr);
+
 /**
  * @brief Unregister a timer service
  *
- * @param timer_id Timer index (0 or 1)
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
  * @param name Service name to unregister
  * @return int Result code
  *         - 0: Unregistration successful
@@ -125,6 +601,424 @@ int rtc_register_service(int timer_id, const char *name, int interval, void (*ca
  */
 int rtc_unregister_service(int timer_id, const char *name);
 
+/**
+ * @brief Set how a service catches up on firings missed during a delayed wakeup
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param policy Catch-up policy
+ * @param max_runs Maximum callback runs per wakeup for RTC_CATCHUP_REPLAY (ignored otherwise)
+ * @return int Result code
+ *         - 0: Policy set
+ *         - -1: Invalid parameters or service not found
+ *
+ * @note When several interrupts coalesce into one wakeup, the service schedule
+ *       still advances by the real number of elapsed ticks. The policy only
+ *       decides how many times the callback runs for the firings that fell in
+ *       the gap.
+ */
+int rtc_set_service_catchup(int timer_id, const char *name, rtc_catchup_policy_t policy, int max_runs);
+
+/**
+ * @brief Set how a service handles firings that come due while its callback is still running
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param policy Overrun policy
+ * @param alarm Called once per overrunning call, after it returns and before any
+ *              owed run; NULL for none
+ * @param alarm_ctx Context passed to the alarm
+ * @return int Result code
+ *         - 0: Policy set
+ *         - -1: Invalid parameters or service not found
+ *
+ * @note With RTC_OVERRUN_QUEUE_ONE and RTC_OVERRUN_COALESCE the owed run follows
+ *       the overrunning call on the same executor without waiting for a tick,
+ *       so a briefly saturated service catches up deterministically. The
+ *       number of overrun firings reaches the callback in info->overruns.
+ */
+int rtc_set_service_overrun(int timer_id, const char *name, rtc_overrun_policy_t policy,
+                            rtc_overrun_alarm_t alarm, void *alarm_ctx);
+
+/**
+ * @brief Change the trigger interval of a running service
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param interval New trigger interval in ticks
+ * @return int Result code
+ *         - 0: Interval change queued
+ *         - -1: Invalid parameters or service not found
+ *
+ * @note The service keeps its statistics and its phase: the next expiry is one
+ *       new interval after the last one (or on the next tick if that has
+ *       already passed), so no unregister/register cycle is needed.
+ */
+int rtc_set_service_interval(int timer_id, const char *name, int interval);
+
+/**
+ * @brief Create a named strand: a serial executor shared by several services
+ *
+ * @param strand Strand name
+ * @param attr Scheduling attributes of the strand thread, NULL for the defaults
+ * @return int Result code
+ *         - 0: Strand created
+ *         - -1: Invalid parameters, name already in use, no free strand or
+ *               the strand thread could not be created with the attributes
+ *
+ * @note Strands live until rtc_cleanup(). Only needed to give a strand
+ *       scheduling attributes; rtc_set_service_strand() creates missing
+ *       strands with the defaults.
+ */
+int rtc_create_strand(const char *strand, const rtc_thread_attr_t *attr);
+
+/**
+ * @brief Run a service on a named strand
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param strand Strand name, created on first use; NULL returns the service
+ *               to the shared pool
+ * @return int Result code
+ *         - 0: Service moved
+ *         - -1: Invalid parameters, service not found, service registered
+ *               with its own scheduling attributes, or the strand could not
+ *               be created
+ *
+ * @note Callbacks of services on the same strand never overlap and run in the
+ *       order their ticks were dispatched, across timers too, so state shared
+ *       only by them needs no lock. Different strands and the shared pool run
+ *       in parallel. A callback still running when the service moves finishes
+ *       before its first run on the new strand; catch-up runs owed by an
+ *       overrunning call follow that call directly.
+ */
+int rtc_set_service_strand(int timer_id, const char *name, const char *strand);
+
+/**
+ * @brief Let a service's firings be delayed so they share wakeups with other services
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param slack Ticks a firing may be delayed (0 ~ interval-1), 0 for a hard deadline
+ * @return int Result code
+ *         - 0: Slack change queued
+ *         - -1: Invalid parameters or service not found
+ *
+ * @note A firing due on tick N runs on the first tick in [N, N+slack] on
+ *       which the timer dispatches anything else, or at N+slack. Firings of
+ *       slack services on the shared pool that come due together run one
+ *       after another in a single executor job. The period stays anchored to
+ *       N, and info->sequence still reports N. In tickless mode the timer is
+ *       programmed for the end of the window rather than the due tick.
+ */
+int rtc_set_service_slack(int timer_id, const char *name, int slack);
+
+/**
+ * @brief Set the CPU utilization ceiling of a timer's services
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param ceiling_permille Ceiling in permille of one CPU, 0 for none
+ * @param policy Action when a registration or budget would exceed it
+ * @return int Result code
+ *         - 0: Ceiling set
+ *         - -1: Invalid parameters
+ *
+ * @note Registration is checked with the budget declared to
+ *       rtc_register_service_ex() on top of the share already taken by the
+ *       timer's services; a rejected service is never started. A service
+ *       without a budget costs nothing until it runs. Existing services are
+ *       never stopped when the ceiling is lowered.
+ */
+int rtc_set_timer_ceiling(int timer_id, int ceiling_permille, rtc_admission_policy_t policy);
+
+/**
+ * @brief Change the CPU cost of one run declared at registration
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param budget_us Cost per run in microseconds, 0 to withdraw the budget for good
+ * @return int Result code
+ *         - 0: Budget set (possibly with an admission warning)
+ *         - -1: Invalid parameters, service not found or registered without
+ *               a budget, or the budget would exceed the timer's ceiling
+ *               under RTC_ADMISSION_ENFORCE; the previous budget stays in effect
+ *
+ * @note A run longer than the budget is counted in budget_overruns and the
+ *       first one is reported. The budget per period needs a known tick
+ *       period: measured, or the one given to rtc_set_tick_backend().
+ */
+int rtc_set_service_budget(int timer_id, const char *name, uint32_t budget_us);
+
+/**
+ * @brief Get the CPU utilization of a timer's services
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param util Output utilization
+ * @return int Result code
+ *         - 0: Utilization computed
+ *         - -1: Invalid parameters
+ */
+int rtc_get_timer_utilization(int timer_id, rtc_timer_utilization_t *util);
+
+/**
+ * @brief Get tick accounting statistics of a timer
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param stats Output statistics
+ * @return int Result code
+ *         - 0: Statistics copied
+ *         - -1: Invalid parameters
+ */
+int rtc_get_timer_stats(int timer_id, rtc_timer_stats_t *stats);
+
+/**
+ * @brief Get execution statistics of a service
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param stats Output statistics
+ * @return int Result code
+ *         - 0: Statistics copied
+ *         - -1: Invalid parameters or service not found
+ */
+int rtc_get_service_stats(int timer_id, const char *name, rtc_service_stats_t *stats);
+
+/**
+ * @brief Get execution statistics of all services on a timer
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param stats Output array
+ * @param max_count Capacity of the output array
+ * @return int Number of services copied, -1 on invalid parameters
+ */
+int rtc_get_all_service_stats(int timer_id, rtc_service_stats_t *stats, int max_count);
+
+/**
+ * @brief Get the measured tick period and drift of a timer
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param drift Output measurement
+ * @return int Result code
+ *         - 0: Measurement copied
+ *         - -1: Invalid parameters
+ *
+ * @note The monitor thread compares the ticks accounted from the interrupt
+ *       count with CLOCK_MONOTONIC over windows of RTC_DRIFT_WINDOW_MS and
+ *       smooths successive windows. Wakeup jitter only enters at the window
+ *       edges, so the estimate resolves a truncated hardware period even
+ *       when individual wakeups are late.
+ */
+int rtc_get_timer_drift(int timer_id, rtc_timer_drift_t *drift);
+
+/**
+ * @brief Get the measured real duration of one tick of a timer
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @return double Seconds per tick, 0 until known or on an invalid timer
+ *
+ * @note Lock-free; meant for services that integrate over time, in place of
+ *       their nominal period. Callbacks also find it in info->tick_seconds.
+ */
+double rtc_get_tick_seconds(int timer_id);
+
+/**
+ * @brief Select the tick backend of a timer
+ *
+ * @param timer_id Timer index (0 ~ RTC_TIMER_MAX - 1)
+ * @param backend Tick backend, e.g. &rtc_tick_backend_timerfd (see rtcTickBackend.h)
+ * @param period_us Tick period in microseconds, 0 for the backend default
+ * @return int Result code
+ *         - 0: Backend selected
+ *         - -1: Invalid parameters or RTC already initialized
+ *
+ * @note Must be called before rtc_init(); timers default to the nuclei
+ *       character devices. Lets the service framework run on hosts without
+ *       the nuclei hardware.
+ */
+int rtc_set_tick_backend(int timer_id, const struct rtc_tick_backend *backend, uint32_t period_us);
+
+/**
+ * @brief Switch a timer between periodic and tickless operation
+ *
+ * @param timer_id Timer index (0 ~ RTC_TIMER_MAX - 1)
+ * @param enable 1 for tickless, 0 for periodic (the default)
+ * @return int Result code
+ *         - 0: Mode set
+ *         - -1: Invalid parameters, backend without one-shot support or RTC already initialized
+ *
+ * @note Must be called after rtc_set_tick_backend() and before rtc_init().
+ *       A tickless timer is programmed in one-pulse mode for the next service
+ *       deadline instead of interrupting every period; the tick sequence seen
+ *       by services is unchanged. An idle timer still wakes at least every
+ *       16384 ticks.
+ */
+int rtc_set_tickless(int timer_id, int enable);
+
+/**
+ * @brief Publish tick counts to other local processes through shared memory
+ *
+ * @param shm_name Name of the shared-memory object (e.g. RTC_TICK_SHM_NAME
+ *                 from rtcTickShm.h), NULL to stop publishing
+ * @return int Result code
+ *         - 0: Setting stored
+ *         - -1: Invalid name or RTC already initialized
+ *
+ * @note Must be called before rtc_init(), which then fails if the page cannot
+ *       be created. Subscribers follow the ticks with rtc_tick_shm_wait()
+ *       without opening the timer devices. Off by default.
+ */
+int rtc_set_tick_publish(const char *shm_name);
+
+/**
+ * @brief Set the scheduling attributes of the IRQ monitor thread
+ *
+ * @param attr Scheduling attributes, NULL to restore the defaults
+ * @return int Result code
+ *         - 0: Attributes stored (and applied to the running monitor thread)
+ *         - -1: Invalid attributes or applying them failed
+ *
+ * @note Policy, priority and CPU mask take effect immediately when the monitor
+ *       is running; stack size takes effect at the next rtc_init().
+ */
+int rtc_set_monitor_attr(const rtc_thread_attr_t *attr);
+
+/* ------------- Latency Tracing Functions ------------- */
+
+/**
+ * @brief Enable or disable latency tracing of a service
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param enable 1 to record a trace of every dispatched run, 0 to stop
+ * @return int Result code
+ *         - 0: Tracing set
+ *         - -1: Invalid parameters or service not found
+ *
+ * @note Each traced run stamps the interrupt (when the tick backend can tell),
+ *       the monitor wakeup, the tick handler, the dispatch, the executor
+ *       start and the point the callback published its output into a shared
+ *       lock-free ring of the last RTC_TRACE_RING_LEN runs of all services.
+ *       Untraced services pay nothing; the interrupt time costs one ioctl
+ *       per wakeup while any service on the timer is traced.
+ */
+int rtc_set_service_trace(int timer_id, const char *name, int enable);
+
+/**
+ * @brief Mark the point at which the running callback made its output visible
+ *
+ * @note Called from inside a service callback, e.g. right after storing a new
+ *       setpoint. Closes the traced run's callback stage; without it the
+ *       stage ends when the callback returns. Does nothing outside a traced run.
+ */
+void rtc_trace_mark(void);
+
+/**
+ * @brief Get per-stage latency percentiles of a traced service
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1)
+ * @param name Service name
+ * @param report Output report over the service's records still in the ring
+ * @return int Result code
+ *         - 0: Report computed
+ *         - -1: Invalid parameters, service not found or out of memory
+ */
+int rtc_get_service_trace(int timer_id, const char *name, rtc_trace_report_t *report);
+
+/* ------------- Tick Source Functions ------------- */
+
+/**
+ * @brief Add a tick source feeding a timer
+ *
+ * @param timer_id Timer index (0 ~ rtc_get_timer_count() - 1) whose services the source drives
+ * @param fd Pollable descriptor whose read() returns a cumulative tick count
+ *           as an unsigned long, with the semantics of /dev/nuclei_rtcN
+ * @return int Result code
+ *         - 0: Source added to the monitor
+ *         - -1: Invalid parameters, table full, RTC not initialized or the
+ *               monitor did not answer within RTC_MONITOR_CTL_TIMEOUT_MS
+ *
+ * @note The descriptor stays owned by the caller and must stay open until
+ *       rtc_remove_tick_source() returns.
+ */
+int rtc_add_tick_source(int timer_id, int fd);
+
+/**
+ * @brief Remove a tick source added with rtc_add_tick_source()
+ *
+ * @param fd Descriptor of the source
+ * @return int Result code
+ *         - 0: Source removed; the monitor no longer reads it
+ *         - -1: Source not found, RTC not initialized or timeout
+ */
+int rtc_remove_tick_source(int fd);
+
+/* ------------- Virtual Time Functions ------------- */
+
+/**
+ * @brief Run services against simulated timers instead of the hardware tick
+ *
+ * @param timer_count Timers to simulate (1 ~ RTC_TIMER_MAX), 0 for real time
+ * @return int Result code
+ *         - 0: Setting stored
+ *         - -1: Invalid count or RTC already initialized
+ *
+ * @note Must be called before rtc_init(). Simulated timers use the emu tick
+ *       backend, which never ticks on its own; the tick period is the one
+ *       given to rtc_set_tick_backend() or RTC_VIRTUAL_TICK_US. rtc_init()
+ *       then starts neither the monitor thread nor the executor pool: time
+ *       only moves inside rtc_virtual_run(). Meant for host runs that cover
+ *       hours of service activity in seconds.
+ */
+int rtc_set_virtual_time(int timer_count);
+
+/**
+ * @brief Advance the virtual clock, running every service due on the way
+ *
+ * @param duration_ns Simulated time to advance
+ * @return int Result code
+ *         - 0: Clock advanced by duration_ns
+ *         - -1: RTC not initialized in virtual time, or the clock would overflow
+ *
+ * @note The clock jumps from one service deadline to the next, and every
+ *       callback runs to completion on the calling thread before it moves
+ *       again, so services run strictly in deadline order and never overrun.
+ *       Timestamps, start latencies and traces are in virtual time; runtimes
+ *       and budgets stay measured in real time. Must not be called from a
+ *       callback; rtc_add_tick_source() is not available in virtual time.
+ */
+int rtc_virtual_run(uint64_t duration_ns);
+
+/**
+ * @brief Get the virtual clock
+ *
+ * @return uint64_t Simulated nanoseconds since rtc_init(), 0 in real time
+ */
+uint64_t rtc_virtual_now_ns(void);
+
+/* ------------- Executor Pool Functions ------------- */
+
+/**
+ * @brief Set the number of callback executor threads
+ *
+ * @param pool_size Number of threads (1 ~ RTC_WORKER_POOL_MAX)
+ * @return int Result code
+ *         - 0: Pool size set
+ *         - -1: Invalid size or RTC already initialized
+ *
+ * @note Must be called before rtc_init(); defaults to RTC_WORKER_POOL_SIZE.
+ */
+int rtc_set_worker_pool_size(int pool_size);
+
+/**
+ * @brief Get callback executor pool statistics
+ *
+ * @param stats Output statistics
+ * @return int Result code
+ *         - 0: Statistics copied
+ *         - -1: Invalid parameter or RTC not initialized
+ */
+int rtc_get_pool_stats(rtc_pool_stats_t *stats);
+
 struct elog_mtd_t{
     struct {
             const char *name;
@@ -0,0 +1,253 @@
+#define _GNU_SOURCE
+#include "rtcExecutor.h"
+#include <sched.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#define RTC_QUEUE_MASK (RTC_WORKER_QUEUE_LEN - 1)
+
+#if (RTC_WORKER_QUEUE_LEN & RTC_QUEUE_MASK) != 0
+#error "RTC_WORKER_QUEUE_LEN must be a power of two"
+#endif
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Raise an atomic maximum
+ */
+static void atomic_max_u64(atomic_uint_least64_t *max, uint64_t value) {
+    uint64_t cur = atomic_load_explicit(max, memory_order_relaxed);
+
+    while (value > cur &&
+           !atomic_compare_exchange_weak_explicit(max, &cur, value,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+/**
+ * @brief Take the oldest job from the queue
+ *
+ * @return int 0 if a job was taken, -1 if the queue is empty
+ */
+static int executor_dequeue(rtc_executor_t *ex, rtc_job_t *job) {
+    size_t pos = atomic_load_explicit(&ex->dequeue_pos, memory_order_relaxed);
+
+    for (;;) {
+        rtc_job_cell_t *cell = &ex->queue[pos & RTC_QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)(pos + 1);
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ex->dequeue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                *job = cell->job;
+                atomic_store_explicit(&cell->seq, pos + RTC_WORKER_QUEUE_LEN, memory_order_release);
+                return 0;
+            }
+        } else if (dif < 0) {
+            return -1;  /* Empty */
+        } else {
+            pos = atomic_load_explicit(&ex->dequeue_pos, memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Executor thread - takes jobs from the queue until stopped
+ */
+static void* rtc_executor_thread(void *arg) {
+    rtc_executor_t *ex = (rtc_executor_t *)arg;
+    rtc_job_t job;
+
+    for (;;) {
+        if (sem_wait(&ex->ready) != 0) {
+            continue;  /* EINTR */
+        }
+
+        if (executor_dequeue(ex, &job) != 0) {
+            if (atomic_load(&ex->stopping)) {
+                break;  /* Stopping and queue drained */
+            }
+            continue;
+        }
+
+        /* Record time from dispatch to start */
+        uint64_t latency = rtc_monotonic_ns() - job.dispatch_ns;
+        atomic_store_explicit(&ex->latency_last_ns, latency, memory_order_relaxed);
+        atomic_fetch_add_explicit(&ex->latency_total_ns, latency, memory_order_relaxed);
+        atomic_max_u64(&ex->latency_max_ns, latency);
+        atomic_fetch_add_explicit(&ex->started, 1, memory_order_relaxed);
+
+        job.func(job.arg);
+    }
+
+    return NULL;
+}
+
+/* ========================= Public Functions ========================= */
+
+/**
+ * @brief Fill pthread attributes from RTC thread attributes
+ */
+int rtc_thread_attr_fill(pthread_attr_t *pattr, const rtc_thread_attr_t *attr) {
+    if (attr->sched_policy != SCHED_OTHER) {
+        struct sched_param param = {.sched_priority = attr->sched_priority};
+        
+        if ((attr->sched_policy != SCHED_FIFO && attr->sched_policy != SCHED_RR) ||
+            attr->sched_priority < sched_get_priority_min(attr->sched_policy) ||
+            attr->sched_priority > sched_get_priority_max(attr->sched_policy)) {
+            printf("Invalid scheduling policy %d / priority %d\n", attr->sched_policy, attr->sched_priority);
+            return -1;
+        }
+        pthread_attr_setinheritsched(pattr, PTHREAD_EXPLICIT_SCHED);
+        pthread_attr_setschedpolicy(pattr, attr->sched_policy);
+        pthread_attr_setschedparam(pattr, &param);
+    }
+    
+    if (attr->cpu_mask) {
+        cpu_set_t set;
+        
+        CPU_ZERO(&set);
+        for (int cpu = 0; cpu < 64; cpu++) {
+            if (attr->cpu_mask & (1ULL << cpu)) {
+                CPU_SET(cpu, &set);
+            }
+        }
+        if (pthread_attr_setaffinity_np(pattr, sizeof(set), &set) != 0) {
+            printf("Invalid CPU mask 0x%llx\n", (unsigned long long)attr->cpu_mask);
+            return -1;
+        }
+    }
+    
+    if (attr->stack_size && pthread_attr_setstacksize(pattr, attr->stack_size) != 0) {
+        printf("Invalid stack size %zu\n", attr->stack_size);
+        return -1;
+    }
+    
+    return 0;
+}
+
+/**
+ * @brief Start an executor with the given number of threads
+ */
+int rtc_executor_start(rtc_executor_t *ex, int thread_count, const rtc_thread_attr_t *attr) {
+    pthread_attr_t pattr;
+    
+    if (!ex || thread_count <= 0 || thread_count > RTC_WORKER_POOL_MAX) {
+        printf("Invalid executor thread count: %d\n", thread_count);
+        return -1;
+    }
+
+    memset(ex, 0, sizeof(*ex));
+    for (size_t i = 0; i < RTC_WORKER_QUEUE_LEN; i++) {
+        atomic_init(&ex->queue[i].seq, i);
+    }
+    if (sem_init(&ex->ready, 0, 0) != 0) {
+        return -1;
+    }
+
+    pthread_attr_init(&pattr);
+    if (attr && rtc_thread_attr_fill(&pattr, attr) != 0) {
+        pthread_attr_destroy(&pattr);
+        sem_destroy(&ex->ready);
+        return -1;
+    }
+
+    for (int i = 0; i < thread_count; i++) {
+        int ret = pthread_create(&ex->threads[i], &pattr, rtc_executor_thread, ex);
+        if (ret != 0) {
+            printf("Failed to create executor thread %d: %s\n", i, strerror(ret));
+            pthread_attr_destroy(&pattr);
+            rtc_executor_stop(ex);
+            return -1;
+        }
+        ex->thread_count++;
+    }
+
+    pthread_attr_destroy(&pattr);
+    return 0;
+}
+
+/**
+ * @brief Stop an executor and join its threads
+ */
+void rtc_executor_stop(rtc_executor_t *ex) {
+    atomic_store(&ex->stopping, 1);
+    for (int i = 0; i < ex->thread_count; i++) {
+        sem_post(&ex->ready);
+    }
+
+    for (int i = 0; i < ex->thread_count; i++) {
+        pthread_join(ex->threads[i], NULL);
+    }
+    ex->thread_count = 0;
+
+    sem_destroy(&ex->ready);
+}
+
+/**
+ * @brief Queue a job on an executor
+ */
+int rtc_executor_submit(rtc_executor_t *ex, void (*func)(void *arg), void *arg) {
+    size_t pos = atomic_load_explicit(&ex->enqueue_pos, memory_order_relaxed);
+    rtc_job_cell_t *cell;
+
+    if (atomic_load_explicit(&ex->stopping, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&ex->dropped, 1, memory_order_relaxed);
+        return -1;
+    }
+
+    for (;;) {
+        cell = &ex->queue[pos & RTC_QUEUE_MASK];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        intptr_t dif = (intptr_t)seq - (intptr_t)pos;
+
+        if (dif == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ex->enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (dif < 0) {
+            atomic_fetch_add_explicit(&ex->dropped, 1, memory_order_relaxed);
+            return -1;  /* Full */
+        } else {
+            pos = atomic_load_explicit(&ex->enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    cell->job.func = func;
+    cell->job.arg = arg;
+    cell->job.dispatch_ns = rtc_monotonic_ns();
+    atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+
+    atomic_fetch_add_explicit(&ex->dispatched, 1, memory_order_relaxed);
+    size_t depth = pos + 1 - atomic_load_explicit(&ex->dequeue_pos, memory_order_relaxed);
+    uint32_t cur = atomic_load_explicit(&ex->depth_max, memory_order_relaxed);
+    while (depth > cur &&
+           !atomic_compare_exchange_weak_explicit(&ex->depth_max, &cur, (uint32_t)depth,
+                                                  memory_order_relaxed, memory_order_relaxed)) {
+    }
+
+    sem_post(&ex->ready);
+    return 0;
+}
+
+/**
+ * @brief Take a snapshot of executor statistics
+ */
+void rtc_executor_get_stats(rtc_executor_t *ex, rtc_pool_stats_t *stats) {
+    size_t enq = atomic_load_explicit(&ex->enqueue_pos, memory_order_relaxed);
+    size_t deq = atomic_load_explicit(&ex->dequeue_pos, memory_order_relaxed);
+
+    memset(stats, 0, sizeof(*stats));
+    stats->pool_size = ex->thread_count;
+    stats->queue_depth = (enq > deq) ? (uint32_t)(enq - deq) : 0;
+    stats->queue_depth_max = atomic_load_explicit(&ex->depth_max, memory_order_relaxed);
+    stats->dispatched = atomic_load_explicit(&ex->dispatched, memory_order_relaxed);
+    stats->started = atomic_load_explicit(&ex->started, memory_order_relaxed);
+    stats->dropped = atomic_load_explicit(&ex->dropped, memory_order_relaxed);
+    stats->start_latency_last_ns = atomic_load_explicit(&ex->latency_last_ns, memory_order_relaxed);
+    stats->start_latency_max_ns = atomic_load_explicit(&ex->latency_max_ns, memory_order_relaxed);
+    stats->start_latency_total_ns = atomic_load_explicit(&ex->latency_total_ns, memory_order_relaxed);
+}
@@ -0,0 +1,114 @@
+#ifndef __RTC_EXECUTOR_H__
+#define __RTC_EXECUTOR_H__
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include "rtcDriver.h"
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Job executed by an executor thread
+ */
+typedef struct {
+    void (*func)(void *arg);        /* Job function */
+    void *arg;                      /* Job argument */
+    uint64_t dispatch_ns;           /* CLOCK_MONOTONIC time the job was queued */
+} rtc_job_t;
+
+/**
+ * @brief Queue cell; seq tells producers and consumers whose turn it is
+ */
+typedef struct {
+    atomic_size_t seq;              /* Sequence number of the cell */
+    rtc_job_t job;                  /* Queued job */
+} rtc_job_cell_t;
+
+/**
+ * @brief Fixed pool of pre-spawned executor threads fed from a bounded queue
+ *
+ * The queue is a lock-free bounded MPMC ring, so submitting from the tick
+ * path never blocks on a mutex. Idle threads sleep on a counting semaphore.
+ */
+typedef struct rtc_executor {
+    rtc_job_cell_t queue[RTC_WORKER_QUEUE_LEN];  /* Ring buffer of pending jobs */
+    atomic_size_t enqueue_pos;                  /* Next position to fill */
+    atomic_size_t dequeue_pos;                  /* Next position to run */
+    sem_t ready;                                /* Counts queued jobs (plus stop wakeups) */
+    pthread_t threads[RTC_WORKER_POOL_MAX];     /* Executor threads */
+    int thread_count;                           /* Number of started threads */
+    atomic_int stopping;                        /* Stop requested */
+
+    /* Statistics, updated with relaxed atomics */
+    atomic_uint_least32_t depth_max;            /* Highest queue depth observed */
+    atomic_uint_least64_t dispatched;           /* Jobs queued */
+    atomic_uint_least64_t started;              /* Jobs picked up */
+    atomic_uint_least64_t dropped;              /* Jobs rejected */
+    atomic_uint_least64_t latency_last_ns;      /* Last dispatch-to-start time */
+    atomic_uint_least64_t latency_max_ns;       /* Maximum dispatch-to-start time */
+    atomic_uint_least64_t latency_total_ns;     /* Sum of dispatch-to-start times */
+} rtc_executor_t;
+
+/* ========================= Function Declarations ========================= */
+
+/**
+ * @brief Get the current CLOCK_MONOTONIC time in nanoseconds
+ */
+static inline uint64_t rtc_monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Fill pthread attributes from RTC thread attributes
+ *
+ * @param pattr Initialized pthread attributes
+ * @param attr RTC thread attributes
+ * @return int 0 on success, -1 if the attributes are invalid
+ */
+int rtc_thread_attr_fill(pthread_attr_t *pattr, const rtc_thread_attr_t *attr);
+
+/**
+ * @brief Start an executor with the given number of threads
+ *
+ * @param ex Executor to start
+ * @param thread_count Number of threads (1 ~ RTC_WORKER_POOL_MAX)
+ * @param attr Scheduling attributes of the threads, NULL for defaults
+ * @return int 0 on success, -1 on failure
+ */
+int rtc_executor_start(rtc_executor_t *ex, int thread_count, const rtc_thread_attr_t *attr);
+
+/**
+ * @brief Stop an executor
+ *
+ * @param ex Executor to stop
+ *
+ * @note Jobs already queued are still executed; returns after all threads joined.
+ */
+void rtc_executor_stop(rtc_executor_t *ex);
+
+/**
+ * @brief Queue a job on an executor
+ *
+ * @param ex Executor
+ * @param func Job function
+ * @param arg Job argument
+ * @return int 0 on success, -1 if the queue is full or the executor is stopping
+ *
+ * @note Lock-free; safe to call from any thread.
+ */
+int rtc_executor_submit(rtc_executor_t *ex, void (*func)(void *arg), void *arg);
+
+/**
+ * @brief Take a snapshot of executor statistics
+ *
+ * @param ex Executor
+ * @param stats Output statistics
+ */
+void rtc_executor_get_stats(rtc_executor_t *ex, rtc_pool_stats_t *stats);
+
+#endif /* __RTC_EXECUTOR_H__ */
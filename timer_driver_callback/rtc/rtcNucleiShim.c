@@ -0,0 +1,522 @@
+/*
+ * LD_PRELOAD emulator of the nuclei timer character devices
+ *
+ * Emulates /dev/nuclei_rtcN and /dev/rtcN with the semantics of rtc-nuclei.c
+ * so rtcDriver.c and the nuclei tick backend run unmodified on a normal
+ * Linux host:
+ *   - read() blocks until an interrupt is pending, then returns the
+ *     cumulative interrupt count as an unsigned long and clears the flag
+ *   - poll()/epoll report POLLIN while an interrupt is pending
+ *   - the first interrupt after enabling is swallowed (irq_flag)
+ *   - RTC_VL_READ / RTC_VL_CLR on /dev/rtcN start and stop the timer
+ *   - NUCLEI_RTC_IOC_ONESHOT / NUCLEI_RTC_IOC_PERIODIC as in the driver
+ *     (one-pulse deadlines are kept in whole periods)
+ *   - NUCLEI_RTC_IOC_IRQ_TIME returns the time of the last counted interrupt
+ *
+ * Build and run:
+ *   gcc -shared -fPIC -O2 -o librtcshim.so rtcNucleiShim.c -ldl -lpthread
+ *   RTC_SHIM_PERIOD_US=1000 LD_PRELOAD=./librtcshim.so ./app
+ *
+ * Environment:
+ *   RTC_SHIM_DEVICES     Number of emulated timers (default 2)
+ *   RTC_SHIM_PERIOD_US   Timer period in microseconds (default 1000)
+ *   RTC_SHIM_BURST       "<every>:<n>" every <every> ticks, hold <n> interrupts
+ *                        and deliver them back to back
+ *   RTC_SHIM_STALL       "<every>:<n>" every <every> ticks, mask interrupts for
+ *                        <n> ticks; the latched update flag raises a single
+ *                        interrupt afterwards, so the ticks in between are lost
+ */
+#define _GNU_SOURCE
+#include "../rtc-nuclei-ioctl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <linux/rtc.h>
+
+#define SHIM_MAX_DEVICES 8          /* Emulated timers */
+#define SHIM_MAX_FD 1024            /* Highest descriptor tracked */
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Emulated timer, the state rtc-nuclei.c keeps in struct nuclei_rtc
+ */
+typedef struct {
+    pthread_mutex_t irq_lock;       /* Protects the fields below */
+    int enabled;                    /* TIMER_CR1_CEN */
+    int irq_flag;                   /* 0 swallows the next interrupt */
+    int irq_pending;                /* Interrupt not read yet */
+    int uif;                        /* Update flag latched while interrupts are masked */
+    unsigned long irq_count;        /* Cumulative interrupt count */
+    unsigned long reported_count;   /* Count last returned by read() */
+    uint64_t irq_ns;                /* CLOCK_MONOTONIC time of the last counted interrupt */
+    uint32_t oneshot_ticks;         /* Periods covered by the armed pulse, 0 when periodic */
+    uint32_t pulse_left;            /* Periods left before the pulse ends */
+    uint32_t held;                  /* Interrupts held back by a burst */
+    int efd;                        /* eventfd readable while irq_pending */
+} shim_device_t;
+
+/**
+ * @brief What an intercepted descriptor refers to
+ */
+typedef enum {
+    SHIM_FD_NONE = 0,
+    SHIM_FD_CHR,                    /* /dev/nuclei_rtcN */
+    SHIM_FD_RTC                     /* /dev/rtcN */
+} shim_fd_type_t;
+
+typedef struct {
+    atomic_int type;                /* shim_fd_type_t */
+    int id;                         /* Device index */
+} shim_fd_t;
+
+/* ========================= Global Variables ========================= */
+
+static shim_device_t shim_devices[SHIM_MAX_DEVICES];
+static shim_fd_t shim_fds[SHIM_MAX_FD];
+static int shim_device_count = 2;
+static uint32_t shim_period_us = 1000;
+static uint32_t burst_every, burst_len;
+static uint32_t stall_every, stall_len;
+static pthread_once_t shim_once = PTHREAD_ONCE_INIT;
+static pthread_t shim_thread;
+
+static int (*real_open)(const char *path, int flags, ...);
+static int (*real_open64)(const char *path, int flags, ...);
+static int (*real_openat)(int dirfd, const char *path, int flags, ...);
+static ssize_t (*real_read)(int fd, void *buf, size_t count);
+static int (*real_ioctl)(int fd, unsigned long request, ...);
+static int (*real_close)(int fd);
+static int (*real_access)(const char *path, int mode);
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Interrupt handler, as nuclei_rtc_irq_handler() (irq_lock held)
+ */
+static void shim_irq(shim_device_t *dev) {
+    struct timespec ts;
+
+    if (dev->irq_flag == 0) {
+        dev->irq_flag = 1;
+        return;
+    }
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    dev->irq_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    dev->irq_count += dev->oneshot_ticks ? dev->oneshot_ticks : 1;
+    if (!dev->irq_pending) {
+        dev->irq_pending = 1;
+        eventfd_write(dev->efd, 1);
+    }
+}
+
+/**
+ * @brief Wake readers without a new interrupt (irq_lock held)
+ */
+static void shim_wake(shim_device_t *dev) {
+    if (!dev->irq_pending) {
+        dev->irq_pending = 1;
+        eventfd_write(dev->efd, 1);
+    }
+}
+
+/**
+ * @brief Stop the counter, counting the whole periods of an interrupted pulse (irq_lock held)
+ */
+static void shim_stop_fold(shim_device_t *dev) {
+    if (dev->oneshot_ticks && dev->enabled) {
+        dev->irq_count += dev->oneshot_ticks - dev->pulse_left;
+    }
+    dev->enabled = 0;
+}
+
+/**
+ * @brief One timer period of one device: count, mask, hold or raise the interrupt
+ */
+static void shim_period(shim_device_t *dev, uint64_t tick) {
+    int stalled = stall_every && (tick % stall_every) < stall_len;
+    int bursting = burst_every && (tick % burst_every) < burst_len;
+
+    pthread_mutex_lock(&dev->irq_lock);
+    if (dev->enabled) {
+        int update = 1;
+
+        if (dev->oneshot_ticks && --dev->pulse_left != 0) {
+            update = 0;
+        } else if (dev->oneshot_ticks) {
+            dev->enabled = 0;  /* TIMER_CR1_OPM clears CEN at the update event */
+        }
+        if (update) {
+            if (stalled) {
+                dev->uif = 1;
+            } else if (bursting) {
+                dev->held++;
+            } else {
+                shim_irq(dev);
+            }
+        }
+    }
+    if (!stalled && dev->uif) {
+        dev->uif = 0;
+        shim_irq(dev);
+    }
+    if (!bursting) {
+        for (; dev->held; dev->held--) {
+            shim_irq(dev);
+        }
+    }
+    pthread_mutex_unlock(&dev->irq_lock);
+}
+
+/**
+ * @brief Timer thread: one period per iteration on an absolute CLOCK_MONOTONIC grid
+ */
+static void* shim_timer_thread(void *arg) {
+    struct timespec next;
+    uint64_t tick = 0;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+    for (;;) {
+        next.tv_nsec += (long)shim_period_us * 1000;
+        while (next.tv_nsec >= 1000000000L) {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR) {
+        }
+
+        for (int i = 0; i < shim_device_count; i++) {
+            shim_period(&shim_devices[i], tick);
+        }
+        tick++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Parse "<every>:<n>"
+ */
+static void shim_parse_pattern(const char *name, uint32_t *every, uint32_t *len) {
+    const char *value = getenv(name);
+    unsigned int a, b;
+
+    if (value && sscanf(value, "%u:%u", &a, &b) == 2 && a > 0 && b < a) {
+        *every = a;
+        *len = b;
+    }
+}
+
+/**
+ * @brief Resolve the real functions, read the configuration and start the timers
+ */
+static void shim_init(void) {
+    const char *value;
+
+    real_open = dlsym(RTLD_NEXT, "open");
+    real_open64 = dlsym(RTLD_NEXT, "open64");
+    real_openat = dlsym(RTLD_NEXT, "openat");
+    real_read = dlsym(RTLD_NEXT, "read");
+    real_ioctl = dlsym(RTLD_NEXT, "ioctl");
+    real_close = dlsym(RTLD_NEXT, "close");
+    real_access = dlsym(RTLD_NEXT, "access");
+
+    if ((value = getenv("RTC_SHIM_DEVICES")) != NULL) {
+        int n = atoi(value);
+        shim_device_count = (n < 1) ? 1 : (n > SHIM_MAX_DEVICES) ? SHIM_MAX_DEVICES : n;
+    }
+    if ((value = getenv("RTC_SHIM_PERIOD_US")) != NULL && atoi(value) > 0) {
+        shim_period_us = (uint32_t)atoi(value);
+    }
+    shim_parse_pattern("RTC_SHIM_BURST", &burst_every, &burst_len);
+    shim_parse_pattern("RTC_SHIM_STALL", &stall_every, &stall_len);
+
+    /* Timers run from probe on, like the driver */
+    for (int i = 0; i < shim_device_count; i++) {
+        shim_device_t *dev = &shim_devices[i];
+
+        pthread_mutex_init(&dev->irq_lock, NULL);
+        dev->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        dev->enabled = 1;
+    }
+    pthread_create(&shim_thread, NULL, shim_timer_thread, NULL);
+    pthread_detach(shim_thread);
+
+    fprintf(stderr, "rtc shim: %d timers, period %uus, burst %u:%u, stall %u:%u\n",
+            shim_device_count, shim_period_us, burst_every, burst_len, stall_every, stall_len);
+}
+
+/**
+ * @brief Map a device path to an emulated device
+ *
+ * @return int Device index, -1 if the path is not emulated
+ */
+static int shim_match(const char *path, shim_fd_type_t *type) {
+    int id;
+    char end;
+
+    if (sscanf(path, "/dev/nuclei_rtc%d%c", &id, &end) == 1) {
+        *type = SHIM_FD_CHR;
+    } else if (sscanf(path, "/dev/rtc%d%c", &id, &end) == 1) {
+        *type = SHIM_FD_RTC;
+    } else {
+        return -1;
+    }
+    return (id >= 0 && id < shim_device_count) ? id : -1;
+}
+
+/**
+ * @brief Open an emulated device
+ *
+ * @return int Descriptor, or -2 if the path is not emulated
+ */
+static int shim_open(const char *path, int flags) {
+    shim_fd_type_t type;
+    int id;
+    int fd;
+
+    pthread_once(&shim_once, shim_init);
+    if (!path || (id = shim_match(path, &type)) < 0) {
+        return -2;
+    }
+
+    /* Every open file shares the device's eventfd, like the driver's wait queue */
+    fd = fcntl(shim_devices[id].efd, (flags & O_CLOEXEC) ? F_DUPFD_CLOEXEC : F_DUPFD, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (fd >= SHIM_MAX_FD) {
+        real_close(fd);
+        errno = EMFILE;
+        return -1;
+    }
+
+    if (type == SHIM_FD_CHR) {
+        pthread_mutex_lock(&shim_devices[id].irq_lock);
+        shim_devices[id].reported_count = shim_devices[id].irq_count;
+        pthread_mutex_unlock(&shim_devices[id].irq_lock);
+    }
+    shim_fds[fd].id = id;
+    atomic_store(&shim_fds[fd].type, type);
+    return fd;
+}
+
+/**
+ * @brief Get the emulated device behind a descriptor
+ */
+static shim_device_t* shim_lookup(int fd, shim_fd_type_t type) {
+    if (fd < 0 || fd >= SHIM_MAX_FD || atomic_load_explicit(&shim_fds[fd].type, memory_order_acquire) != (int)type) {
+        return NULL;
+    }
+    return &shim_devices[shim_fds[fd].id];
+}
+
+/**
+ * @brief NUCLEI_RTC_IOC_ONESHOT, as nuclei_rtc_chr_ioctl()
+ */
+static int shim_ioctl_oneshot(shim_device_t *dev, struct nuclei_rtc_oneshot *req) {
+    uint32_t max = nuclei_rtc_oneshot_max_ticks(shim_period_us);
+    unsigned long target;
+
+    if (req->ticks == 0 || req->reserved) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pthread_mutex_lock(&dev->irq_lock);
+    shim_stop_fold(dev);
+    target = dev->reported_count + req->ticks;
+    if ((long)(target - dev->irq_count) <= 0) {
+        dev->oneshot_ticks = 0;
+        shim_wake(dev);
+    } else {
+        unsigned long left = target - dev->irq_count;
+
+        dev->oneshot_ticks = (left > max) ? max : (uint32_t)left;
+        dev->pulse_left = dev->oneshot_ticks;
+        dev->irq_flag = 1;
+        dev->uif = 0;
+        dev->enabled = 1;
+    }
+    req->count = dev->reported_count;
+    pthread_mutex_unlock(&dev->irq_lock);
+    return 0;
+}
+
+/* ========================= Intercepted Functions ========================= */
+
+int open(const char *path, int flags, ...) {
+    mode_t mode = 0;
+    va_list ap;
+    int fd = shim_open(path, flags);
+
+    if (fd != -2) {
+        return fd;
+    }
+    va_start(ap, flags);
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        mode = va_arg(ap, mode_t);
+    }
+    va_end(ap);
+    return real_open(path, flags, mode);
+}
+
+int open64(const char *path, int flags, ...) {
+    mode_t mode = 0;
+    va_list ap;
+    int fd = shim_open(path, flags);
+
+    if (fd != -2) {
+        return fd;
+    }
+    va_start(ap, flags);
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        mode = va_arg(ap, mode_t);
+    }
+    va_end(ap);
+    return real_open64(path, flags, mode);
+}
+
+int openat(int dirfd, const char *path, int flags, ...) {
+    mode_t mode = 0;
+    va_list ap;
+    int fd = shim_open(path, flags);
+
+    if (fd != -2) {
+        return fd;
+    }
+    va_start(ap, flags);
+    if (flags & (O_CREAT | O_TMPFILE)) {
+        mode = va_arg(ap, mode_t);
+    }
+    va_end(ap);
+    return real_openat(dirfd, path, flags, mode);
+}
+
+int access(const char *path, int mode) {
+    shim_fd_type_t type;
+
+    pthread_once(&shim_once, shim_init);
+    if (shim_match(path, &type) >= 0) {
+        return 0;
+    }
+    return real_access(path, mode);
+}
+
+/**
+ * @brief read(), as nuclei_rtc_read(): block until pending, return the count
+ */
+ssize_t read(int fd, void *buf, size_t count) {
+    shim_device_t *dev;
+    unsigned long irq_count;
+    eventfd_t value;
+
+    pthread_once(&shim_once, shim_init);
+    if ((dev = shim_lookup(fd, SHIM_FD_CHR)) == NULL) {
+        return real_read(fd, buf, count);
+    }
+    if (count < sizeof(unsigned long)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    pthread_mutex_lock(&dev->irq_lock);
+    while (!dev->irq_pending) {
+        struct pollfd pfd = {.fd = fd, .events = POLLIN};
+
+        pthread_mutex_unlock(&dev->irq_lock);
+        if (poll(&pfd, 1, -1) < 0 && errno == EINTR) {
+            return -1;
+        }
+        pthread_mutex_lock(&dev->irq_lock);
+    }
+    irq_count = dev->irq_count;
+    dev->reported_count = irq_count;
+    dev->irq_pending = 0;
+    eventfd_read(dev->efd, &value);
+    pthread_mutex_unlock(&dev->irq_lock);
+
+    memcpy(buf, &irq_count, sizeof(irq_count));
+    return sizeof(irq_count);
+}
+
+int ioctl(int fd, unsigned long request, ...) {
+    shim_device_t *dev;
+    va_list ap;
+    void *arg;
+
+    va_start(ap, request);
+    arg = va_arg(ap, void *);
+    va_end(ap);
+
+    pthread_once(&shim_once, shim_init);
+    if ((dev = shim_lookup(fd, SHIM_FD_CHR)) != NULL) {
+        switch (request) {
+            case NUCLEI_RTC_IOC_ONESHOT:
+                return shim_ioctl_oneshot(dev, (struct nuclei_rtc_oneshot *)arg);
+
+            case NUCLEI_RTC_IOC_PERIODIC:
+                pthread_mutex_lock(&dev->irq_lock);
+                shim_stop_fold(dev);
+                dev->oneshot_ticks = 0;
+                dev->irq_flag = 1;
+                dev->enabled = 1;
+                pthread_mutex_unlock(&dev->irq_lock);
+                return 0;
+
+            case NUCLEI_RTC_IOC_IRQ_TIME:
+                pthread_mutex_lock(&dev->irq_lock);
+                *(uint64_t *)arg = dev->irq_ns;
+                pthread_mutex_unlock(&dev->irq_lock);
+                return 0;
+
+            default:
+                errno = ENOTTY;
+                return -1;
+        }
+    }
+
+    if ((dev = shim_lookup(fd, SHIM_FD_RTC)) != NULL) {
+        switch (request) {
+            case RTC_VL_READ:
+                pthread_mutex_lock(&dev->irq_lock);
+                dev->oneshot_ticks = 0;
+                dev->uif = 0;
+                dev->enabled = 1;
+                pthread_mutex_unlock(&dev->irq_lock);
+                return 0;
+
+            case RTC_VL_CLR:
+                pthread_mutex_lock(&dev->irq_lock);
+                dev->irq_flag = 0;
+                dev->uif = 0;
+                dev->enabled = 0;
+                pthread_mutex_unlock(&dev->irq_lock);
+                return 0;
+
+            default:
+                errno = ENOTTY;
+                return -1;
+        }
+    }
+
+    return real_ioctl(fd, request, arg);
+}
+
+int close(int fd) {
+    pthread_once(&shim_once, shim_init);
+    if (fd >= 0 && fd < SHIM_MAX_FD) {
+        atomic_store(&shim_fds[fd].type, SHIM_FD_NONE);
+    }
+    return real_close(fd);
+}
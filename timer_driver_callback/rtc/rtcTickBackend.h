@@ -0,0 +1,119 @@
+#ifndef __RTC_TICK_BACKEND_H__
+#define __RTC_TICK_BACKEND_H__
+
+#include <stdint.h>
+#include "rtcDriver.h"
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Tick source backend
+ *
+ * A backend turns some periodic event into a pollable descriptor whose
+ * read_count() yields a cumulative tick count, the same contract as the
+ * nuclei character device. The monitor thread waits on dev->fd with epoll
+ * and calls read_count() when it becomes readable; wait() is for users
+ * driving a device without the monitor thread.
+ */
+typedef struct rtc_tick_backend {
+    const char *name;                                           /* Backend name for logs */
+
+    /**
+     * @brief Open the device and set dev->fd
+     * @return int 0 on success, -1 on failure
+     */
+    int (*open)(rtc_device_t *dev);
+
+    /**
+     * @brief Start periodic ticks
+     * @param period_us Tick period in microseconds, 0 for the backend default
+     * @return int 0 on success, -1 if the period cannot be applied
+     */
+    int (*arm)(rtc_device_t *dev, uint32_t period_us);
+
+    /**
+     * @brief Wait until a tick is pending
+     * @param timeout_ms Maximum wait, -1 for no limit
+     * @return int 1 if a tick is pending, 0 on timeout, -1 on error
+     */
+    int (*wait)(rtc_device_t *dev, int timeout_ms);
+
+    /**
+     * @brief Read the cumulative tick count
+     * @return int 0 on success, -1 if nothing could be read
+     */
+    int (*read_count)(rtc_device_t *dev, unsigned long *count);
+
+    /**
+     * @brief Fire a single tick covering several periods (tickless mode)
+     * @param ticks Periods after the count last returned by read_count(); the
+     *              backend may clamp long requests
+     * @param base Output: count last returned by read_count(), the base of ticks
+     * @return int 0 on success, -1 on failure
+     * @note Optional, NULL when the backend only runs periodically. The count
+     *       read afterwards has advanced by the periods actually covered.
+     */
+    int (*oneshot)(rtc_device_t *dev, uint32_t ticks, unsigned long *base);
+
+    /**
+     * @brief Get the CLOCK_MONOTONIC time of the tick last returned by read_count()
+     * @param ns Output: tick time in nanoseconds
+     * @return int 0 on success, -1 if unknown
+     * @note Optional, NULL when the backend cannot timestamp its ticks. Only
+     *       called while a service on the timer is traced.
+     */
+    int (*irq_time)(rtc_device_t *dev, uint64_t *ns);
+
+    /**
+     * @brief Stop ticks and close dev->fd
+     */
+    void (*close)(rtc_device_t *dev);
+} rtc_tick_backend_t;
+
+/* ========================= Backends ========================= */
+
+/* Nuclei hardware timer via /dev/nuclei_rtcN; the period comes from the device tree */
+extern const rtc_tick_backend_t rtc_tick_backend_nuclei;
+
+/* timerfd on CLOCK_MONOTONIC; runs on any Linux host */
+extern const rtc_tick_backend_t rtc_tick_backend_timerfd;
+
+/*
+ * Emulated nuclei register block. Time only moves through
+ * rtc_tick_emu_advance(), so the one-pulse programming done by the kernel
+ * driver can be checked deterministically on a host.
+ */
+extern const rtc_tick_backend_t rtc_tick_backend_emu;
+
+#define RTC_TICK_EMU_PERIOD 100     /* Emulated counter counts per tick */
+
+/**
+ * @brief Emulated timer registers, same meaning as NUCLEI_CR1 ... NUCLEI_ARR
+ */
+typedef struct {
+    uint32_t cr1;                   /* Control: CEN bit 0, OPM bit 3 */
+    uint32_t dier;                  /* Update interrupt enable */
+    uint32_t sr;                    /* Update interrupt flag */
+    uint32_t cnt;                   /* Counter */
+    uint32_t arr;                   /* Auto-reload value */
+    unsigned long irq_count;        /* Driver interrupt count */
+    unsigned long irqs;             /* Interrupts raised */
+} rtc_tick_emu_regs_t;
+
+/**
+ * @brief Advance the emulated counter of an opened emu device
+ *
+ * @param id Device index (timer id)
+ * @param counts Counter counts to advance; each update event raises an interrupt
+ * @return int 0 on success, -1 if the device is not open
+ */
+int rtc_tick_emu_advance(int id, uint64_t counts);
+
+/**
+ * @brief Read the emulated registers of an opened emu device
+ *
+ * @return int 0 on success, -1 if the device is not open
+ */
+int rtc_tick_emu_get_regs(int id, rtc_tick_emu_regs_t *regs);
+
+#endif /* __RTC_TICK_BACKEND_H__ */
@@ -0,0 +1,293 @@
+#include "rtcTickBackend.h"
+#include "../rtc-nuclei-ioctl.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+#include <pthread.h>
+#include <time.h>
+#include <sys/eventfd.h>
+
+#define RTC_TICK_EMU_MAX 8          /* Emulated devices */
+
+/* Register bits, same layout as the nuclei timer */
+#define EMU_CR1_CEN     (1U << 0)
+#define EMU_CR1_OPM     (1U << 3)
+#define EMU_DIER_UIE    (1U << 0)
+#define EMU_SR_UIF      (1U << 0)
+
+/**
+ * @brief Emulated device: register block plus the state kept by rtc-nuclei.c
+ */
+typedef struct {
+    pthread_mutex_t lock;           /* Serializes register access, like irq_lock */
+    rtc_tick_emu_regs_t regs;       /* Register block and interrupt counters */
+    unsigned long reported;         /* Count last returned by read_count() */
+    uint32_t oneshot_ticks;         /* Periods covered by the armed pulse, 0 when periodic */
+    uint32_t pulse_rem;             /* Counts of its period already elapsed when the pulse started */
+    uint64_t irq_ns;                /* CLOCK_MONOTONIC time of the last interrupt */
+    uint64_t reported_ns;           /* irq_ns as of the last read_count() */
+    int pending;                    /* Interrupt not read yet */
+    int efd;                        /* eventfd standing in for the wait queue */
+} emu_device_t;
+
+static emu_device_t *emu_devices[RTC_TICK_EMU_MAX];
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Update interrupt, as in nuclei_rtc_irq_handler() (lock held)
+ */
+static void emu_irq(emu_device_t *emu) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    emu->irq_ns = (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+    emu->regs.sr &= ~EMU_SR_UIF;
+    emu->regs.irq_count += emu->oneshot_ticks ? emu->oneshot_ticks : 1;
+    emu->regs.irqs++;
+    emu->pending = 1;
+    eventfd_write(emu->efd, 1);
+}
+
+/**
+ * @brief Stop the counter and count whole periods of an interrupted pulse (lock held)
+ *
+ * A pulse counts from pulse_rem counts into its first period, so the grid
+ * position is the counter plus that offset. A periodic counter already sits
+ * at its position within the period.
+ *
+ * @return uint32_t Counts already elapsed in the current period
+ */
+static uint32_t emu_stop_fold(emu_device_t *emu) {
+    uint32_t rem = 0;
+
+    if (emu->regs.cr1 & EMU_CR1_CEN) {
+        if (emu->oneshot_ticks) {
+            uint32_t pos = emu->regs.cnt + emu->pulse_rem;
+
+            emu->regs.irq_count += pos / RTC_TICK_EMU_PERIOD;
+            rem = pos % RTC_TICK_EMU_PERIOD;
+        } else {
+            rem = emu->regs.cnt;
+        }
+    }
+    emu->regs.cr1 &= ~EMU_CR1_CEN;
+    return rem;
+}
+
+/**
+ * @brief Load ARR, reset the counter and start it (lock held)
+ */
+static void emu_start(emu_device_t *emu, uint32_t arr, int oneshot) {
+    emu->regs.arr = arr;
+    emu->regs.cnt = 0;              /* Update generation */
+    emu->regs.sr = 0;
+    emu->regs.dier = EMU_DIER_UIE;
+    if (oneshot) {
+        emu->regs.cr1 |= EMU_CR1_OPM;
+    } else {
+        emu->regs.cr1 &= ~EMU_CR1_OPM;
+    }
+    emu->regs.cr1 |= EMU_CR1_CEN;
+}
+
+/**
+ * @brief Create the emulated device; the timer starts periodic like after RTC_VL_READ
+ */
+static int emu_open(rtc_device_t *dev) {
+    emu_device_t *emu;
+
+    if (dev->id < 0 || dev->id >= RTC_TICK_EMU_MAX || emu_devices[dev->id]) {
+        printf("Invalid emulated RTC device %d\n", dev->id);
+        return -1;
+    }
+    emu = calloc(1, sizeof(*emu));
+    if (!emu) {
+        return -1;
+    }
+    emu->efd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (emu->efd < 0) {
+        perror("Failed to create emulated RTC eventfd");
+        free(emu);
+        return -1;
+    }
+    pthread_mutex_init(&emu->lock, NULL);
+    emu_start(emu, RTC_TICK_EMU_PERIOD - 1, 0);
+
+    dev->fd = emu->efd;
+    dev->priv = emu;
+    emu_devices[dev->id] = emu;
+    return 0;
+}
+
+/**
+ * @brief Accept any period; emulated time runs in RTC_TICK_EMU_PERIOD counts per tick regardless
+ */
+static int emu_arm(rtc_device_t *dev, uint32_t period_us) {
+    (void)dev;
+    (void)period_us;
+    return 0;
+}
+
+/**
+ * @brief Wait until an interrupt is pending
+ */
+static int emu_wait(rtc_device_t *dev, int timeout_ms) {
+    struct pollfd pfd = {.fd = dev->fd, .events = POLLIN};
+    int ret = poll(&pfd, 1, timeout_ms);
+
+    if (ret < 0) {
+        return -1;
+    }
+    return (ret > 0 && (pfd.revents & POLLIN)) ? 1 : 0;
+}
+
+/**
+ * @brief Return the interrupt count, as nuclei_rtc_read() does
+ */
+static int emu_read_count(rtc_device_t *dev, unsigned long *count) {
+    emu_device_t *emu = dev->priv;
+    eventfd_t value;
+    int ret = -1;
+
+    pthread_mutex_lock(&emu->lock);
+    if (emu->pending) {
+        eventfd_read(emu->efd, &value);
+        emu->pending = 0;
+        emu->reported = emu->regs.irq_count;
+        emu->reported_ns = emu->irq_ns;
+        *count = emu->regs.irq_count;
+        ret = 0;
+    }
+    pthread_mutex_unlock(&emu->lock);
+    return ret;
+}
+
+/**
+ * @brief Program a pulse, as the NUCLEI_RTC_IOC_ONESHOT ioctl does
+ */
+static int emu_oneshot(rtc_device_t *dev, uint32_t ticks, unsigned long *base) {
+    emu_device_t *emu = dev->priv;
+
+    if (ticks == 0) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&emu->lock);
+    uint32_t rem = emu_stop_fold(emu);
+    unsigned long target = emu->reported + ticks;
+
+    if ((long)(target - emu->regs.irq_count) <= 0) {
+        emu->oneshot_ticks = 0;
+        emu->pending = 1;
+        eventfd_write(emu->efd, 1);
+    } else {
+        unsigned long left = target - emu->regs.irq_count;
+        uint32_t max = nuclei_rtc_oneshot_max_ticks(RTC_TICK_EMU_PERIOD);
+
+        emu->oneshot_ticks = (left > max) ? max : (uint32_t)left;
+        emu->pulse_rem = rem;
+        emu_start(emu, nuclei_rtc_oneshot_arr(RTC_TICK_EMU_PERIOD, emu->oneshot_ticks, rem), 1);
+    }
+    *base = emu->reported;
+    pthread_mutex_unlock(&emu->lock);
+    return 0;
+}
+
+/**
+ * @brief Real time at which the interrupt behind the last read count was raised
+ */
+static int emu_irq_time(rtc_device_t *dev, uint64_t *ns) {
+    emu_device_t *emu = dev->priv;
+    int ret = -1;
+
+    pthread_mutex_lock(&emu->lock);
+    if (emu->reported_ns) {
+        *ns = emu->reported_ns;
+        ret = 0;
+    }
+    pthread_mutex_unlock(&emu->lock);
+    return ret;
+}
+
+/**
+ * @brief Destroy the emulated device
+ */
+static void emu_close(rtc_device_t *dev) {
+    emu_device_t *emu = dev->priv;
+
+    if (!emu) {
+        return;
+    }
+    emu_devices[dev->id] = NULL;
+    close(emu->efd);
+    pthread_mutex_destroy(&emu->lock);
+    free(emu);
+    dev->fd = -1;
+    dev->priv = NULL;
+}
+
+/* ========================= Public Functions ========================= */
+
+/**
+ * @brief Advance the emulated counter of an opened emu device
+ */
+int rtc_tick_emu_advance(int id, uint64_t counts) {
+    emu_device_t *emu = (id >= 0 && id < RTC_TICK_EMU_MAX) ? emu_devices[id] : NULL;
+
+    if (!emu) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&emu->lock);
+    while (counts && (emu->regs.cr1 & EMU_CR1_CEN)) {
+        uint64_t to_update = (uint64_t)emu->regs.arr - emu->regs.cnt + 1;
+
+        if (counts < to_update) {
+            emu->regs.cnt += (uint32_t)counts;
+            break;
+        }
+        /* Counter reached ARR: update event */
+        counts -= to_update;
+        emu->regs.cnt = 0;
+        emu->regs.sr |= EMU_SR_UIF;
+        if (emu->regs.cr1 & EMU_CR1_OPM) {
+            emu->regs.cr1 &= ~EMU_CR1_CEN;
+        }
+        if (emu->regs.dier & EMU_DIER_UIE) {
+            emu_irq(emu);
+        }
+    }
+    pthread_mutex_unlock(&emu->lock);
+    return 0;
+}
+
+/**
+ * @brief Read the emulated registers of an opened emu device
+ */
+int rtc_tick_emu_get_regs(int id, rtc_tick_emu_regs_t *regs) {
+    emu_device_t *emu = (id >= 0 && id < RTC_TICK_EMU_MAX) ? emu_devices[id] : NULL;
+
+    if (!emu || !regs) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&emu->lock);
+    *regs = emu->regs;
+    pthread_mutex_unlock(&emu->lock);
+    return 0;
+}
+
+/* ========================= Backend ========================= */
+
+const rtc_tick_backend_t rtc_tick_backend_emu = {
+    .name = "emu",
+    .open = emu_open,
+    .arm = emu_arm,
+    .wait = emu_wait,
+    .read_count = emu_read_count,
+    .oneshot = emu_oneshot,
+    .irq_time = emu_irq_time,
+    .close = emu_close,
+};
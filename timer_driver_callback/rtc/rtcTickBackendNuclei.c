@@ -0,0 +1,109 @@
+#include "rtcTickBackend.h"
+#include "../rtc-nuclei-ioctl.h"
+#include <stdio.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Open the nuclei character device
+ */
+static int nuclei_open(rtc_device_t *dev) {
+    dev->fd = open(dev->device_path, O_RDWR);
+    if (dev->fd < 0) {
+        perror("Failed to open RTC device");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief The nuclei timer runs from probe on; only the default period is accepted
+ */
+static int nuclei_arm(rtc_device_t *dev, uint32_t period_us) {
+    if (period_us != 0) {
+        printf("RTC device %s: period is fixed by the device tree\n", dev->device_path);
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Wait for the driver's interrupt pending flag
+ */
+static int nuclei_wait(rtc_device_t *dev, int timeout_ms) {
+    struct pollfd pfd = {.fd = dev->fd, .events = POLLIN};
+    int ret = poll(&pfd, 1, timeout_ms);
+
+    if (ret < 0) {
+        return -1;
+    }
+    return (ret > 0 && (pfd.revents & POLLIN)) ? 1 : 0;
+}
+
+/**
+ * @brief The driver returns its cumulative interrupt count directly
+ */
+static int nuclei_read_count(rtc_device_t *dev, unsigned long *count) {
+    if (read(dev->fd, count, sizeof(*count)) != sizeof(*count)) {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Program a one-pulse deadline; the driver sets TIMER_CR1_OPM and NUCLEI_ARR
+ */
+static int nuclei_oneshot(rtc_device_t *dev, uint32_t ticks, unsigned long *base) {
+    struct nuclei_rtc_oneshot req = {.ticks = ticks};
+
+    if (ioctl(dev->fd, NUCLEI_RTC_IOC_ONESHOT, &req) != 0) {
+        perror("Failed to program RTC one-pulse deadline");
+        return -1;
+    }
+    *base = (unsigned long)req.count;
+    return 0;
+}
+
+/**
+ * @brief The driver stamps every counted interrupt
+ */
+static int nuclei_irq_time(rtc_device_t *dev, uint64_t *ns) {
+    __u64 irq_ns = 0;
+
+    if (ioctl(dev->fd, NUCLEI_RTC_IOC_IRQ_TIME, &irq_ns) != 0 || irq_ns == 0) {
+        return -1;
+    }
+    *ns = irq_ns;
+    return 0;
+}
+
+/**
+ * @brief Close the character device
+ */
+static void nuclei_close(rtc_device_t *dev) {
+    if (dev->fd >= 0) {
+        /* Leave the timer periodic for the next user */
+        if (dev->tickless) {
+            ioctl(dev->fd, NUCLEI_RTC_IOC_PERIODIC);
+        }
+        close(dev->fd);
+        dev->fd = -1;
+    }
+}
+
+/* ========================= Backend ========================= */
+
+const rtc_tick_backend_t rtc_tick_backend_nuclei = {
+    .name = "nuclei",
+    .open = nuclei_open,
+    .arm = nuclei_arm,
+    .wait = nuclei_wait,
+    .read_count = nuclei_read_count,
+    .oneshot = nuclei_oneshot,
+    .irq_time = nuclei_irq_time,
+    .close = nuclei_close,
+};
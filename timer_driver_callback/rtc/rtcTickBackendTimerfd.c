@@ -0,0 +1,189 @@
+#include "rtcTickBackend.h"
+#include "rtcExecutor.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/timerfd.h>
+
+/* Period used when none is configured */
+#define RTC_TIMERFD_DEFAULT_PERIOD_US 1000000U
+
+/**
+ * @brief timerfd backend state
+ */
+typedef struct {
+    uint64_t period_ns;             /* Tick period */
+    unsigned long count;            /* Cumulative tick count */
+    unsigned long reported;         /* Count last returned by read_count() */
+    int periodic;                   /* Periodic mode; otherwise a one-shot is armed */
+    uint32_t oneshot_ticks;         /* Periods counted when the armed one-shot expires */
+    uint64_t boundary_ns;           /* Period boundary of the last counted tick */
+} timerfd_state_t;
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Create a non-blocking CLOCK_MONOTONIC timerfd
+ */
+static int timerfd_backend_open(rtc_device_t *dev) {
+    timerfd_state_t *st = calloc(1, sizeof(*st));
+
+    if (!st) {
+        return -1;
+    }
+    dev->fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (dev->fd < 0) {
+        perror("Failed to create timerfd");
+        free(st);
+        return -1;
+    }
+    st->period_ns = (uint64_t)RTC_TIMERFD_DEFAULT_PERIOD_US * 1000ULL;
+    dev->priv = st;
+    return 0;
+}
+
+/**
+ * @brief Start the periodic timer; the first tick is one period from now
+ */
+static int timerfd_backend_arm(rtc_device_t *dev, uint32_t period_us) {
+    timerfd_state_t *st = dev->priv;
+    struct itimerspec its;
+
+    if (period_us == 0) {
+        period_us = RTC_TIMERFD_DEFAULT_PERIOD_US;
+    }
+    st->period_ns = (uint64_t)period_us * 1000ULL;
+    st->periodic = 1;
+    its.it_interval.tv_sec = period_us / 1000000U;
+    its.it_interval.tv_nsec = (long)(period_us % 1000000U) * 1000L;
+    its.it_value = its.it_interval;
+
+    if (timerfd_settime(dev->fd, 0, &its, NULL) != 0) {
+        perror("Failed to arm timerfd");
+        return -1;
+    }
+    st->boundary_ns = rtc_monotonic_ns();
+    return 0;
+}
+
+/**
+ * @brief Wait until the timer has expired at least once
+ */
+static int timerfd_backend_wait(rtc_device_t *dev, int timeout_ms) {
+    struct pollfd pfd = {.fd = dev->fd, .events = POLLIN};
+    int ret = poll(&pfd, 1, timeout_ms);
+
+    if (ret < 0) {
+        return -1;
+    }
+    return (ret > 0 && (pfd.revents & POLLIN)) ? 1 : 0;
+}
+
+/**
+ * @brief Fold the expirations since the last read into a cumulative count
+ */
+static int timerfd_backend_read_count(rtc_device_t *dev, unsigned long *count) {
+    timerfd_state_t *st = dev->priv;
+    uint64_t expirations;
+
+    if (read(dev->fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return -1;
+    }
+    if (st->periodic) {
+        st->count += (unsigned long)expirations;
+        st->boundary_ns += expirations * st->period_ns;
+    } else {
+        /* A one-shot expires once but covers several periods */
+        st->count += st->oneshot_ticks;
+        st->boundary_ns += (uint64_t)st->oneshot_ticks * st->period_ns;
+        st->oneshot_ticks = 0;
+    }
+    st->reported = st->count;
+    *count = st->count;
+    return 0;
+}
+
+/**
+ * @brief Arm a one-shot on the period grid
+ *
+ * Whole periods of an interrupted one-shot are counted as elapsed, so
+ * re-arming never shifts later ticks off the grid.
+ */
+static int timerfd_backend_oneshot(rtc_device_t *dev, uint32_t ticks, unsigned long *base) {
+    timerfd_state_t *st = dev->priv;
+    struct itimerspec its = {0};
+    unsigned long target = st->reported + ticks;
+    uint64_t elapsed;
+
+    if (ticks == 0) {
+        return -1;
+    }
+    *base = st->reported;
+
+    if (st->periodic) {
+        /* Leaving periodic mode: take in expirations not read yet */
+        uint64_t expirations;
+        if (read(dev->fd, &expirations, sizeof(expirations)) == sizeof(expirations)) {
+            st->count += (unsigned long)expirations;
+            st->boundary_ns += expirations * st->period_ns;
+        }
+        st->periodic = 0;
+    }
+
+    /* Whole periods gone since the last counted tick are counted now */
+    elapsed = (rtc_monotonic_ns() - st->boundary_ns) / st->period_ns;
+    st->boundary_ns += elapsed * st->period_ns;
+    st->count += (unsigned long)elapsed;
+
+    /* 0 when the deadline already passed: the timer fires at once */
+    st->oneshot_ticks = (target > st->count) ? (uint32_t)(target - st->count) : 0;
+
+    uint64_t deadline = st->boundary_ns + (uint64_t)st->oneshot_ticks * st->period_ns;
+    if (deadline == 0) {
+        deadline = 1;   /* A zero it_value would disarm */
+    }
+    its.it_value.tv_sec = (time_t)(deadline / 1000000000ULL);
+    its.it_value.tv_nsec = (long)(deadline % 1000000000ULL);
+    if (timerfd_settime(dev->fd, TFD_TIMER_ABSTIME, &its, NULL) != 0) {
+        perror("Failed to arm timerfd one-shot");
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief The last counted tick expired on its period boundary
+ */
+static int timerfd_backend_irq_time(rtc_device_t *dev, uint64_t *ns) {
+    timerfd_state_t *st = dev->priv;
+
+    *ns = st->boundary_ns;
+    return 0;
+}
+
+/**
+ * @brief Close the timerfd, which also disarms it
+ */
+static void timerfd_backend_close(rtc_device_t *dev) {
+    if (dev->fd >= 0) {
+        close(dev->fd);
+        dev->fd = -1;
+    }
+    free(dev->priv);
+    dev->priv = NULL;
+}
+
+/* ========================= Backend ========================= */
+
+const rtc_tick_backend_t rtc_tick_backend_timerfd = {
+    .name = "timerfd",
+    .open = timerfd_backend_open,
+    .arm = timerfd_backend_arm,
+    .wait = timerfd_backend_wait,
+    .read_count = timerfd_backend_read_count,
+    .oneshot = timerfd_backend_oneshot,
+    .irq_time = timerfd_backend_irq_time,
+    .close = timerfd_backend_close,
+};
@@ -0,0 +1,220 @@
+#define _GNU_SOURCE
+#include "rtcTickShm.h"
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Current CLOCK_MONOTONIC time in nanoseconds
+ */
+static uint64_t tick_shm_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Sleep on a futex word shared between processes
+ */
+static int tick_shm_futex(atomic_uint *word, int op, unsigned int val, const struct timespec *timeout) {
+    return (int)syscall(SYS_futex, (unsigned int *)word, op, val, timeout, NULL, 0);
+}
+
+/* ========================= Public Functions ========================= */
+
+/**
+ * @brief Create and map the shared-memory page, replacing a stale one
+ */
+rtc_tick_shm_t* rtc_tick_shm_create(const char *name, int timer_count) {
+    if (!name || timer_count <= 0 || timer_count > RTC_TICK_SHM_TIMERS) {
+        printf("Invalid tick publish parameters\n");
+        return NULL;
+    }
+
+    /* A page left by a publisher that died is recreated, not reused */
+    shm_unlink(name);
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, RTC_TICK_SHM_MODE);
+    if (fd < 0) {
+        printf("Failed to create tick page %s: %s\n", name, strerror(errno));
+        return NULL;
+    }
+    if (ftruncate(fd, sizeof(rtc_tick_shm_t)) != 0) {
+        printf("Failed to size tick page %s: %s\n", name, strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return NULL;
+    }
+
+    rtc_tick_shm_t *shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        printf("Failed to map tick page %s: %s\n", name, strerror(errno));
+        shm_unlink(name);
+        return NULL;
+    }
+
+    /* ftruncate() zero-filled the page; the magic goes last so openers see a complete header */
+    shm->version = RTC_TICK_SHM_VERSION;
+    shm->timer_count = (uint32_t)timer_count;
+    atomic_thread_fence(memory_order_release);
+    shm->magic = RTC_TICK_SHM_MAGIC;
+    return shm;
+}
+
+/**
+ * @brief Publish a timer's tick count; publisher thread only
+ */
+void rtc_tick_shm_publish(rtc_tick_shm_t *shm, int timer_id, uint64_t ticks,
+                          uint64_t timestamp_ns, uint64_t tick_ps) {
+    rtc_tick_shm_timer_t *t = &shm->timer[timer_id];
+    unsigned int seq = atomic_load_explicit(&t->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&t->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&t->ticks, ticks, memory_order_relaxed);
+    atomic_store_explicit(&t->timestamp_ns, timestamp_ns, memory_order_relaxed);
+    atomic_store_explicit(&t->tick_ps, tick_ps, memory_order_relaxed);
+    atomic_store_explicit(&t->seq, seq + 2, memory_order_release);
+
+    /* Pairs with the waiter count taken before a subscriber sleeps */
+    atomic_fetch_add(&t->futex, 1);
+    if (atomic_load(&t->waiters)) {
+        tick_shm_futex(&t->futex, FUTEX_WAKE, INT32_MAX, NULL);
+    }
+}
+
+/**
+ * @brief Mark the page closed, wake every subscriber, unmap and unlink it
+ */
+void rtc_tick_shm_destroy(rtc_tick_shm_t *shm, const char *name) {
+    if (!shm) {
+        return;
+    }
+
+    atomic_store(&shm->closed, 1);
+    for (uint32_t i = 0; i < shm->timer_count; i++) {
+        atomic_fetch_add(&shm->timer[i].futex, 1);
+        tick_shm_futex(&shm->timer[i].futex, FUTEX_WAKE, INT32_MAX, NULL);
+    }
+    munmap(shm, sizeof(*shm));
+    shm_unlink(name);
+}
+
+/**
+ * @brief Map a page created by a publishing process
+ */
+rtc_tick_shm_t* rtc_tick_shm_open(const char *name) {
+    struct stat st;
+    int fd = shm_open(name, O_RDWR, 0);
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(rtc_tick_shm_t)) {
+        close(fd);
+        return NULL;
+    }
+
+    rtc_tick_shm_t *shm = mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        return NULL;
+    }
+
+    /* Still being set up, or written by a different layout */
+    if (shm->magic != RTC_TICK_SHM_MAGIC) {
+        munmap(shm, sizeof(*shm));
+        return NULL;
+    }
+    atomic_thread_fence(memory_order_acquire);
+    if (shm->version != RTC_TICK_SHM_VERSION ||
+        shm->timer_count == 0 || shm->timer_count > RTC_TICK_SHM_TIMERS) {
+        printf("Tick page %s has an unknown layout\n", name);
+        munmap(shm, sizeof(*shm));
+        return NULL;
+    }
+    return shm;
+}
+
+/**
+ * @brief Read the latest published state of a timer
+ */
+int rtc_tick_shm_read(const rtc_tick_shm_t *shm, int timer_id, rtc_tick_sample_t *sample) {
+    if (!shm || !sample || timer_id < 0 || (uint32_t)timer_id >= shm->timer_count) {
+        return -1;
+    }
+
+    rtc_tick_shm_timer_t *t = (rtc_tick_shm_timer_t *)&shm->timer[timer_id];
+    unsigned int seq;
+    uint64_t tick_ps;
+
+    do {
+        seq = atomic_load_explicit(&t->seq, memory_order_acquire);
+        sample->ticks = atomic_load_explicit(&t->ticks, memory_order_relaxed);
+        sample->timestamp_ns = atomic_load_explicit(&t->timestamp_ns, memory_order_relaxed);
+        tick_ps = atomic_load_explicit(&t->tick_ps, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || seq != atomic_load_explicit(&t->seq, memory_order_relaxed));
+
+    sample->tick_seconds = (double)tick_ps * 1e-12;
+    return atomic_load_explicit(&shm->closed, memory_order_acquire) ? -1 : 0;
+}
+
+/**
+ * @brief Wait until a timer has accounted more than after_ticks ticks
+ */
+int rtc_tick_shm_wait(rtc_tick_shm_t *shm, int timer_id, uint64_t after_ticks,
+                      rtc_tick_sample_t *sample, int timeout_ms) {
+    uint64_t deadline = (timeout_ms >= 0) ? tick_shm_now_ns() + (uint64_t)timeout_ms * 1000000ULL : 0;
+
+    if (!shm || !sample || timer_id < 0 || (uint32_t)timer_id >= shm->timer_count) {
+        return -1;
+    }
+
+    rtc_tick_shm_timer_t *t = &shm->timer[timer_id];
+    for (;;) {
+        /* Taken before the check, so a publish in between makes the wait return at once */
+        unsigned int word = atomic_load(&t->futex);
+
+        if (rtc_tick_shm_read(shm, timer_id, sample) != 0) {
+            return -1;
+        }
+        if (sample->ticks > after_ticks) {
+            return 0;
+        }
+
+        struct timespec ts, *timeout = NULL;
+        if (timeout_ms >= 0) {
+            uint64_t now = tick_shm_now_ns();
+            if (now >= deadline) {
+                return -1;
+            }
+            ts.tv_sec = (time_t)((deadline - now) / 1000000000ULL);
+            ts.tv_nsec = (long)((deadline - now) % 1000000000ULL);
+            timeout = &ts;
+        }
+
+        atomic_fetch_add(&t->waiters, 1);
+        tick_shm_futex(&t->futex, FUTEX_WAIT, word, timeout);
+        atomic_fetch_sub(&t->waiters, 1);
+    }
+}
+
+/**
+ * @brief Unmap a page opened with rtc_tick_shm_open()
+ */
+void rtc_tick_shm_close(rtc_tick_shm_t *shm) {
+    if (shm) {
+        munmap(shm, sizeof(*shm));
+    }
+}
@@ -0,0 +1,130 @@
+#ifndef __RTC_TICK_SHM_H__
+#define __RTC_TICK_SHM_H__
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+/*
+ * Cross-process tick distribution
+ *
+ * The process running rtc_init() owns the timer devices. With publishing
+ * enabled (rtc_set_tick_publish()) its monitor thread writes every timer's
+ * tick count and timestamp into a POSIX shared-memory page, so other local
+ * processes follow the same hardware tick without opening the device and
+ * stealing its wakeups. Subscribers only need this header and rtcTickShm.c:
+ *
+ *     rtc_tick_shm_t *shm = rtc_tick_shm_open(RTC_TICK_SHM_NAME);
+ *     rtc_tick_sample_t s = {0};
+ *
+ *     while (rtc_tick_shm_wait(shm, 0, s.ticks, &s, 1000) == 0) {
+ *         handle_tick(s.ticks, s.timestamp_ns);
+ *     }
+ *     rtc_tick_shm_close(shm);    (publisher gone: reopen later)
+ *
+ * A publish is a seqlock write plus a futex word increment; FUTEX_WAKE is
+ * only issued while a subscriber is sleeping on that timer.
+ */
+
+#define RTC_TICK_SHM_NAME "/nuclei_rtc_ticks"   /* Default shared-memory object name */
+#define RTC_TICK_SHM_MAGIC 0x52544354           /* "RTCT" */
+#define RTC_TICK_SHM_VERSION 1                  /* Layout version */
+#define RTC_TICK_SHM_TIMERS 8                   /* Timer entries in the page (RTC_TIMER_MAX) */
+#define RTC_TICK_SHM_MODE 0660                  /* Subscribers map the page read-write to register as waiters */
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Published state of one timer, one cache line each
+ */
+typedef struct {
+    atomic_uint futex;                      /* Incremented after every publish; subscribers sleep on it */
+    atomic_uint waiters;                    /* Subscribers sleeping on futex */
+    atomic_uint seq;                        /* Seqlock: odd while the fields below are written */
+    uint32_t reserved;
+    atomic_uint_least64_t ticks;            /* Ticks accounted since the publisher's rtc_init() */
+    atomic_uint_least64_t timestamp_ns;     /* CLOCK_MONOTONIC of the wakeup that accounted them */
+    atomic_uint_least64_t tick_ps;          /* Measured tick period in picoseconds, 0 until known */
+    uint64_t pad[3];
+} __attribute__((aligned(64))) rtc_tick_shm_timer_t;
+
+/**
+ * @brief Shared-memory page written by the publishing monitor thread
+ */
+typedef struct {
+    uint32_t magic;                         /* RTC_TICK_SHM_MAGIC once the page is ready */
+    uint32_t version;                       /* RTC_TICK_SHM_VERSION */
+    uint32_t timer_count;                   /* Timers published */
+    atomic_uint closed;                     /* Set when the publisher stops; the object is unlinked */
+    rtc_tick_shm_timer_t timer[RTC_TICK_SHM_TIMERS];
+} rtc_tick_shm_t;
+
+/**
+ * @brief Consistent copy of one timer's published state
+ */
+typedef struct {
+    uint64_t ticks;                         /* Ticks accounted since the publisher's rtc_init() */
+    uint64_t timestamp_ns;                  /* CLOCK_MONOTONIC of the wakeup that accounted them */
+    double tick_seconds;                    /* Measured tick period, 0 until known */
+} rtc_tick_sample_t;
+
+/* ========================= Function Declarations ========================= */
+
+/* ------------- Publisher ------------- */
+
+/**
+ * @brief Create and map the shared-memory page, replacing a stale one
+ *
+ * @param name Object name for shm_open(), starting with '/'
+ * @param timer_count Timers to publish (1 ~ RTC_TICK_SHM_TIMERS)
+ * @return rtc_tick_shm_t* Mapped page, NULL on failure
+ */
+rtc_tick_shm_t* rtc_tick_shm_create(const char *name, int timer_count);
+
+/**
+ * @brief Publish a timer's tick count; publisher thread only
+ */
+void rtc_tick_shm_publish(rtc_tick_shm_t *shm, int timer_id, uint64_t ticks,
+                          uint64_t timestamp_ns, uint64_t tick_ps);
+
+/**
+ * @brief Mark the page closed, wake every subscriber, unmap and unlink it
+ */
+void rtc_tick_shm_destroy(rtc_tick_shm_t *shm, const char *name);
+
+/* ------------- Subscriber ------------- */
+
+/**
+ * @brief Map a page created by a publishing process
+ *
+ * @return rtc_tick_shm_t* Mapped page, NULL if it does not exist or does not match this layout
+ */
+rtc_tick_shm_t* rtc_tick_shm_open(const char *name);
+
+/**
+ * @brief Read the latest published state of a timer
+ *
+ * @return int 0 on success, -1 for an invalid timer or a closed page
+ */
+int rtc_tick_shm_read(const rtc_tick_shm_t *shm, int timer_id, rtc_tick_sample_t *sample);
+
+/**
+ * @brief Wait until a timer has accounted more than after_ticks ticks
+ *
+ * @param after_ticks Tick count already seen, 0 to return on the first publish
+ * @param sample Latest state once the wait ends
+ * @param timeout_ms Maximum wait, -1 for none
+ * @return int Result code
+ *         - 0: New ticks published
+ *         - -1: Timeout, invalid timer, or the publisher stopped (close and reopen)
+ *
+ * @note A subscriber that falls behind sees all ticks it missed in one sample.
+ */
+int rtc_tick_shm_wait(rtc_tick_shm_t *shm, int timer_id, uint64_t after_ticks,
+                      rtc_tick_sample_t *sample, int timeout_ms);
+
+/**
+ * @brief Unmap a page opened with rtc_tick_shm_open()
+ */
+void rtc_tick_shm_close(rtc_tick_shm_t *shm);
+
+#endif /* __RTC_TICK_SHM_H__ */
@@ -0,0 +1,192 @@
+#include "rtcTimerWheel.h"
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief Append an entry to a list
+ */
+static void wheel_list_append(rtc_wheel_node_t *head, rtc_wheel_node_t *node) {
+    node->prev = head->prev;
+    node->next = head;
+    head->prev->next = node;
+    head->prev = node;
+}
+
+/**
+ * @brief Select the slot for an entry relative to the next tick and link it
+ */
+static void wheel_link(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *node) {
+    uint64_t expires = node->expires;
+    rtc_wheel_node_t *slot;
+
+    if (expires < wheel->next_tick) {
+        /* Already due: expire on the next tick */
+        slot = &wheel->root[wheel->next_tick & (RTC_WHEEL_ROOT_SIZE - 1)];
+    } else {
+        uint64_t delta = expires - wheel->next_tick;
+
+        if (delta < RTC_WHEEL_ROOT_SIZE) {
+            slot = &wheel->root[expires & (RTC_WHEEL_ROOT_SIZE - 1)];
+        } else {
+            int level = 0;
+            unsigned int shift = RTC_WHEEL_ROOT_BITS;
+
+            if (delta > RTC_WHEEL_MAX_DELTA) {
+                /* Beyond the wheel span: park in the last outer slot, re-cascaded later */
+                expires = wheel->next_tick + RTC_WHEEL_MAX_DELTA;
+                delta = RTC_WHEEL_MAX_DELTA;
+            }
+            while (level < RTC_WHEEL_OUTER_LEVELS - 1 &&
+                   delta >= (1ULL << (shift + RTC_WHEEL_LEVEL_BITS))) {
+                level++;
+                shift += RTC_WHEEL_LEVEL_BITS;
+            }
+            slot = &wheel->outer[level][(expires >> shift) & (RTC_WHEEL_LEVEL_SIZE - 1)];
+        }
+    }
+
+    wheel_list_append(slot, node);
+}
+
+/**
+ * @brief Move all entries of an outer slot down to lower wheels
+ *
+ * @return uint32_t Index of the cascaded slot (0 means the level above must cascade too)
+ */
+static uint32_t wheel_cascade(rtc_timer_wheel_t *wheel, int level) {
+    unsigned int shift = RTC_WHEEL_ROOT_BITS + level * RTC_WHEEL_LEVEL_BITS;
+    uint32_t index = (uint32_t)(wheel->next_tick >> shift) & (RTC_WHEEL_LEVEL_SIZE - 1);
+    rtc_wheel_node_t pending;
+    rtc_wheel_node_t *node;
+
+    /* Detach the slot first; re-linking may target the same slot when clamped */
+    rtc_wheel_list_init(&pending);
+    if (wheel->outer[level][index].next != &wheel->outer[level][index]) {
+        pending.next = wheel->outer[level][index].next;
+        pending.prev = wheel->outer[level][index].prev;
+        pending.next->prev = &pending;
+        pending.prev->next = &pending;
+        rtc_wheel_list_init(&wheel->outer[level][index]);
+    }
+
+    while ((node = rtc_wheel_list_pop(&pending)) != NULL) {
+        wheel_link(wheel, node);
+    }
+
+    return index;
+}
+
+/* ========================= Public Functions ========================= */
+
+/**
+ * @brief Initialize a timing wheel
+ */
+void rtc_wheel_init(rtc_timer_wheel_t *wheel) {
+    for (uint32_t i = 0; i < RTC_WHEEL_ROOT_SIZE; i++) {
+        rtc_wheel_list_init(&wheel->root[i]);
+    }
+    for (int level = 0; level < RTC_WHEEL_OUTER_LEVELS; level++) {
+        for (uint32_t i = 0; i < RTC_WHEEL_LEVEL_SIZE; i++) {
+            rtc_wheel_list_init(&wheel->outer[level][i]);
+        }
+    }
+    wheel->next_tick = 1;
+    wheel->count = 0;
+}
+
+/**
+ * @brief Link an entry to expire at an absolute tick
+ */
+void rtc_wheel_add(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *node, uint64_t expires) {
+    node->expires = expires;
+    wheel_link(wheel, node);
+    wheel->count++;
+}
+
+/**
+ * @brief Unlink an entry
+ */
+void rtc_wheel_remove(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *node) {
+    if (!node->next) {
+        return;
+    }
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    node->next = NULL;
+    node->prev = NULL;
+    wheel->count--;
+}
+
+/**
+ * @brief Process the next tick
+ */
+uint64_t rtc_wheel_advance(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *expired) {
+    uint64_t tick = wheel->next_tick;
+    uint32_t index = (uint32_t)(tick & (RTC_WHEEL_ROOT_SIZE - 1));
+    rtc_wheel_node_t *slot;
+
+    /* Root wheel wrapped: pull the next span down from the outer wheels */
+    if (index == 0) {
+        for (int level = 0; level < RTC_WHEEL_OUTER_LEVELS; level++) {
+            if (wheel_cascade(wheel, level) != 0) {
+                break;
+            }
+        }
+    }
+
+    wheel->next_tick++;
+
+    /* Hand the whole slot over to the caller */
+    slot = &wheel->root[index];
+    if (slot->next != slot) {
+        rtc_wheel_node_t *node;
+
+        expired->next = slot->next;
+        expired->prev = slot->prev;
+        expired->next->prev = expired;
+        expired->prev->next = expired;
+        rtc_wheel_list_init(slot);
+
+        for (node = expired->next; node != expired; node = node->next) {
+            wheel->count--;
+        }
+    }
+
+    return tick;
+}
+
+/**
+ * @brief Get the tick of the earliest linked entry
+ */
+uint64_t rtc_wheel_next_expiry(const rtc_timer_wheel_t *wheel) {
+    uint64_t next = UINT64_MAX;
+
+    if (wheel->count == 0) {
+        return next;
+    }
+
+    /* Root slots are ordered from the next tick */
+    for (uint32_t i = 0; i < RTC_WHEEL_ROOT_SIZE; i++) {
+        const rtc_wheel_node_t *slot = &wheel->root[(wheel->next_tick + i) & (RTC_WHEEL_ROOT_SIZE - 1)];
+
+        if (slot->next != slot) {
+            next = wheel->next_tick + i;
+            break;
+        }
+    }
+
+    /* Outer slots are not ordered by expiry near the wrap point; scan them all */
+    for (int level = 0; level < RTC_WHEEL_OUTER_LEVELS; level++) {
+        for (uint32_t i = 0; i < RTC_WHEEL_LEVEL_SIZE; i++) {
+            const rtc_wheel_node_t *slot = &wheel->outer[level][i];
+
+            for (const rtc_wheel_node_t *node = slot->next; node != slot; node = node->next) {
+                if (node->expires < next) {
+                    next = node->expires;
+                }
+            }
+        }
+    }
+
+    return (next < wheel->next_tick) ? wheel->next_tick : next;
+}
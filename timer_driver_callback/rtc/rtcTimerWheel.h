@@ -0,0 +1,123 @@
+#ifndef __RTC_TIMER_WHEEL_H__
+#define __RTC_TIMER_WHEEL_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* ========================= Macro Definitions ========================= */
+
+/*
+ * Hierarchical timing wheel geometry: a 256-slot root wheel holding the
+ * next 256 ticks, plus three 64-slot outer wheels each covering 64 times
+ * the span of the wheel below. Entries further out than 2^26 ticks are
+ * clamped to the last outer slot.
+ */
+#define RTC_WHEEL_ROOT_BITS 8
+#define RTC_WHEEL_LEVEL_BITS 6
+#define RTC_WHEEL_OUTER_LEVELS 3
+#define RTC_WHEEL_ROOT_SIZE (1U << RTC_WHEEL_ROOT_BITS)
+#define RTC_WHEEL_LEVEL_SIZE (1U << RTC_WHEEL_LEVEL_BITS)
+#define RTC_WHEEL_MAX_DELTA ((1ULL << (RTC_WHEEL_ROOT_BITS + RTC_WHEEL_OUTER_LEVELS * RTC_WHEEL_LEVEL_BITS)) - 1)
+
+/* Get the structure containing a wheel node */
+#define RTC_WHEEL_ENTRY(ptr, type, member) \
+    ((type *)((char *)(ptr) - offsetof(type, member)))
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Timing wheel entry, embedded in the owning structure
+ */
+typedef struct rtc_wheel_node {
+    struct rtc_wheel_node *next;    /* Next entry (NULL when not linked) */
+    struct rtc_wheel_node *prev;    /* Previous entry */
+    uint64_t expires;               /* Absolute tick at which the entry expires */
+} rtc_wheel_node_t;
+
+/**
+ * @brief Hierarchical timing wheel
+ */
+typedef struct {
+    rtc_wheel_node_t root[RTC_WHEEL_ROOT_SIZE];                         /* Next 256 ticks */
+    rtc_wheel_node_t outer[RTC_WHEEL_OUTER_LEVELS][RTC_WHEEL_LEVEL_SIZE];/* Cascading outer wheels */
+    uint64_t next_tick;             /* Next tick to be processed */
+    uint32_t count;                 /* Number of linked entries */
+} rtc_timer_wheel_t;
+
+/* ========================= Function Declarations ========================= */
+
+/**
+ * @brief Initialize a timing wheel; the first processed tick is 1
+ */
+void rtc_wheel_init(rtc_timer_wheel_t *wheel);
+
+/**
+ * @brief Get the number of the last processed tick
+ */
+static inline uint64_t rtc_wheel_now(const rtc_timer_wheel_t *wheel) {
+    return wheel->next_tick - 1;
+}
+
+/**
+ * @brief Link an entry to expire at an absolute tick
+ *
+ * @param wheel Timing wheel
+ * @param node Unlinked entry
+ * @param expires Absolute tick; ticks already processed expire on the next tick
+ */
+void rtc_wheel_add(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *node, uint64_t expires);
+
+/**
+ * @brief Unlink an entry; no-op if the entry is not linked
+ */
+void rtc_wheel_remove(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *node);
+
+/**
+ * @brief Process the next tick
+ *
+ * @param wheel Timing wheel
+ * @param expired Empty list head (see rtc_wheel_list_init) receiving the entries
+ *                expiring on this tick
+ * @return uint64_t Number of the processed tick
+ *
+ * @note Cost is O(1) per tick plus the number of expiring entries; outer wheel
+ *       cascades are amortized over the span they cover.
+ */
+uint64_t rtc_wheel_advance(rtc_timer_wheel_t *wheel, rtc_wheel_node_t *expired);
+
+/**
+ * @brief Get the tick of the earliest linked entry
+ *
+ * @param wheel Timing wheel
+ * @return uint64_t Absolute tick (at least the next tick), UINT64_MAX if the wheel is empty
+ *
+ * @note Scans the root wheel up to the first non-empty slot and every outer
+ *       entry; meant for reprogramming a one-shot timer, not the tick path.
+ */
+uint64_t rtc_wheel_next_expiry(const rtc_timer_wheel_t *wheel);
+
+/**
+ * @brief Initialize an empty list head
+ */
+static inline void rtc_wheel_list_init(rtc_wheel_node_t *head) {
+    head->next = head;
+    head->prev = head;
+}
+
+/**
+ * @brief Remove and return the first entry of a list, NULL if empty
+ */
+static inline rtc_wheel_node_t *rtc_wheel_list_pop(rtc_wheel_node_t *head) {
+    rtc_wheel_node_t *node = head->next;
+
+    if (node == head) {
+        return NULL;
+    }
+    head->next = node->next;
+    node->next->prev = head;
+    node->next = NULL;
+    node->prev = NULL;
+    return node;
+}
+
+#endif /* __RTC_TIMER_WHEEL_H__ */
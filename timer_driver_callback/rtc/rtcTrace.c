@@ -0,0 +1,163 @@
+#include "rtcTrace.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RTC_TRACE_MASK (RTC_TRACE_RING_LEN - 1)
+
+#if (RTC_TRACE_RING_LEN & RTC_TRACE_MASK) != 0
+#error "RTC_TRACE_RING_LEN must be a power of two"
+#endif
+
+#define TRACE_SEQ_EMPTY 0U
+#define TRACE_SEQ_BUSY  1U
+
+/* Points bounding each stage of rtc_trace_stage_t; the total starts at the earliest known point */
+static const struct {
+    rtc_trace_point_t from;
+    rtc_trace_point_t to;
+} trace_stage_points[RTC_TRACE_STAGES] = {
+    [RTC_TRACE_STAGE_IRQ]      = {RTC_TRACE_IRQ, RTC_TRACE_WAKEUP},
+    [RTC_TRACE_STAGE_READ]     = {RTC_TRACE_WAKEUP, RTC_TRACE_TICK},
+    [RTC_TRACE_STAGE_DISPATCH] = {RTC_TRACE_TICK, RTC_TRACE_DISPATCH},
+    [RTC_TRACE_STAGE_QUEUE]    = {RTC_TRACE_DISPATCH, RTC_TRACE_START},
+    [RTC_TRACE_STAGE_CALLBACK] = {RTC_TRACE_START, RTC_TRACE_PUBLISH},
+    [RTC_TRACE_STAGE_TOTAL]    = {RTC_TRACE_IRQ, RTC_TRACE_PUBLISH},
+};
+
+/* ========================= Private Functions ========================= */
+
+/**
+ * @brief qsort comparator for durations
+ */
+static int trace_cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Nearest-rank percentile of sorted samples, in permille
+ */
+static uint64_t trace_percentile(const uint64_t *sorted, uint32_t count, uint32_t permille) {
+    uint64_t rank = ((uint64_t)count * permille + 999) / 1000;
+
+    return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+/* ========================= Public Functions ========================= */
+
+/**
+ * @brief Append a record, overwriting the oldest one
+ */
+void rtc_trace_ring_push(rtc_trace_ring_t *ring, const rtc_trace_record_t *rec) {
+    size_t pos = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    rtc_trace_cell_t *cell = &ring->cells[pos & RTC_TRACE_MASK];
+    size_t seq = atomic_load_explicit(&cell->seq, memory_order_relaxed);
+
+    /* A writer that lapped the ring is still on this cell: drop rather than wait */
+    if (seq == TRACE_SEQ_BUSY ||
+        !atomic_compare_exchange_strong_explicit(&cell->seq, &seq, TRACE_SEQ_BUSY,
+                                                 memory_order_relaxed, memory_order_relaxed)) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    atomic_thread_fence(memory_order_release);
+
+    atomic_store_explicit(&cell->owner, rec->owner, memory_order_relaxed);
+    atomic_store_explicit(&cell->generation, rec->generation, memory_order_relaxed);
+    for (int i = 0; i < RTC_TRACE_POINTS; i++) {
+        atomic_store_explicit(&cell->stamp[i], rec->stamp[i], memory_order_relaxed);
+    }
+    atomic_store_explicit(&cell->seq, 2 * pos + 2, memory_order_release);
+}
+
+/**
+ * @brief Copy the records of one service still held by the ring
+ */
+int rtc_trace_ring_collect(rtc_trace_ring_t *ring, const void *owner, unsigned int generation,
+                           rtc_trace_record_t *out, int max_count) {
+    int count = 0;
+
+    for (size_t i = 0; i < RTC_TRACE_RING_LEN && count < max_count; i++) {
+        rtc_trace_cell_t *cell = &ring->cells[i];
+        size_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        rtc_trace_record_t *rec = &out[count];
+
+        if (seq == TRACE_SEQ_EMPTY || seq == TRACE_SEQ_BUSY ||
+            atomic_load_explicit(&cell->owner, memory_order_relaxed) != owner ||
+            atomic_load_explicit(&cell->generation, memory_order_relaxed) != generation) {
+            continue;
+        }
+        rec->owner = owner;
+        rec->generation = generation;
+        for (int p = 0; p < RTC_TRACE_POINTS; p++) {
+            rec->stamp[p] = atomic_load_explicit(&cell->stamp[p], memory_order_relaxed);
+        }
+
+        /* Keep the copy only if no writer touched the cell meanwhile */
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&cell->seq, memory_order_relaxed) == seq) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * @brief Compute per-stage percentiles of a set of records
+ */
+void rtc_trace_summarize(const rtc_trace_record_t *recs, int count, rtc_trace_report_t *report) {
+    uint64_t *samples = (count > 0) ? malloc(sizeof(uint64_t) * (size_t)count) : NULL;
+
+    memset(report, 0, sizeof(*report));
+    report->records = (uint32_t)count;
+    if (!samples) {
+        return;
+    }
+
+    for (int s = 0; s < RTC_TRACE_STAGES; s++) {
+        rtc_trace_stage_stats_t *st = &report->stage[s];
+        uint32_t n = 0;
+
+        for (int i = 0; i < count; i++) {
+            uint64_t from = recs[i].stamp[trace_stage_points[s].from];
+            uint64_t to = recs[i].stamp[trace_stage_points[s].to];
+
+            if (s == RTC_TRACE_STAGE_TOTAL && from == 0) {
+                from = recs[i].stamp[RTC_TRACE_WAKEUP];
+            }
+            /* Stages with an unknown end, or a backend stamp past the wakeup, are left out */
+            if (from == 0 || to == 0 || to < from) {
+                continue;
+            }
+            samples[n++] = to - from;
+        }
+        if (n == 0) {
+            continue;
+        }
+
+        qsort(samples, n, sizeof(uint64_t), trace_cmp_u64);
+        st->samples = n;
+        st->p50_ns = trace_percentile(samples, n, 500);
+        st->p90_ns = trace_percentile(samples, n, 900);
+        st->p99_ns = trace_percentile(samples, n, 990);
+        st->max_ns = samples[n - 1];
+    }
+
+    free(samples);
+}
+
+/**
+ * @brief Forget every record
+ *
+ * @note Only safe while no executor pushes, e.g. after the pool is stopped.
+ */
+void rtc_trace_ring_reset(rtc_trace_ring_t *ring) {
+    for (size_t i = 0; i < RTC_TRACE_RING_LEN; i++) {
+        atomic_store_explicit(&ring->cells[i].seq, TRACE_SEQ_EMPTY, memory_order_relaxed);
+    }
+    atomic_store(&ring->head, 0);
+    atomic_store(&ring->dropped, 0);
+}
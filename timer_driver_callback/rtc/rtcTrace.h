@@ -0,0 +1,84 @@
+#ifndef __RTC_TRACE_H__
+#define __RTC_TRACE_H__
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "rtcDriver.h"
+
+/* ========================= Data Structures ========================= */
+
+/**
+ * @brief Points stamped along the path of a traced callback run
+ */
+typedef enum {
+    RTC_TRACE_IRQ = 0,              /* Timer interrupt, from the tick backend (0 if unknown) */
+    RTC_TRACE_WAKEUP,               /* Monitor returned from epoll_wait */
+    RTC_TRACE_TICK,                 /* Tick count read, tick handler entered */
+    RTC_TRACE_DISPATCH,             /* Job queued to the executor */
+    RTC_TRACE_START,                /* Executor picked the job up */
+    RTC_TRACE_PUBLISH,              /* Callback called rtc_trace_mark(), or returned */
+    RTC_TRACE_POINTS
+} rtc_trace_point_t;
+
+/**
+ * @brief Timestamps of one traced callback run, CLOCK_MONOTONIC nanoseconds
+ */
+typedef struct {
+    const void *owner;              /* Service slot that produced the record */
+    unsigned int generation;        /* Slot generation, tells a recycled slot apart */
+    uint64_t stamp[RTC_TRACE_POINTS];
+} rtc_trace_record_t;
+
+/**
+ * @brief Ring cell; seq is 0 while empty, 1 while being written, 2 * position + 2 once valid
+ */
+typedef struct {
+    atomic_size_t seq;
+    _Atomic(const void *) owner;
+    atomic_uint generation;
+    atomic_uint_least64_t stamp[RTC_TRACE_POINTS];
+} rtc_trace_cell_t;
+
+/**
+ * @brief Lock-free ring of the latest trace records
+ *
+ * Any number of executors push concurrently; a push never waits and
+ * overwrites the oldest record. Readers copy cells optimistically and
+ * drop any that changed underneath them.
+ */
+typedef struct {
+    rtc_trace_cell_t cells[RTC_TRACE_RING_LEN];
+    atomic_size_t head;             /* Next position to write */
+    atomic_uint_least64_t dropped;  /* Records lost to a concurrent writer of the same cell */
+} rtc_trace_ring_t;
+
+/* ========================= Function Declarations ========================= */
+
+/**
+ * @brief Append a record, overwriting the oldest one
+ */
+void rtc_trace_ring_push(rtc_trace_ring_t *ring, const rtc_trace_record_t *rec);
+
+/**
+ * @brief Copy the records of one service still held by the ring
+ *
+ * @param owner Service slot
+ * @param generation Slot generation of the service
+ * @param out Output array
+ * @param max_count Capacity of the output array
+ * @return int Number of records copied
+ */
+int rtc_trace_ring_collect(rtc_trace_ring_t *ring, const void *owner, unsigned int generation,
+                           rtc_trace_record_t *out, int max_count);
+
+/**
+ * @brief Compute per-stage percentiles of a set of records
+ */
+void rtc_trace_summarize(const rtc_trace_record_t *recs, int count, rtc_trace_report_t *report);
+
+/**
+ * @brief Forget every record
+ */
+void rtc_trace_ring_reset(rtc_trace_ring_t *ring);
+
+#endif /* __RTC_TRACE_H__ */